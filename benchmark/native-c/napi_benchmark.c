@@ -119,6 +119,48 @@ static napi_value napi_object_read(napi_env env, napi_callback_info info) {
   return create_int32(env, count + (flag ? 1 : 0));
 }
 
+static const char* const wide_struct_fields[] = {
+    "f0", "f1", "f2",  "f3",  "f4",  "f5",  "f6",  "f7",
+    "f8", "f9", "f10", "f11", "f12", "f13", "f14", "f15",
+};
+
+#define WIDE_STRUCT_FIELD_COUNT (sizeof(wide_struct_fields) / sizeof(wide_struct_fields[0]))
+
+static napi_value napi_wide_struct_sum(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!get_args(env, info, 1, args)) return undefined_value(env);
+
+  int32_t total = 0;
+  for (size_t i = 0; i < WIDE_STRUCT_FIELD_COUNT; i++) {
+    napi_value element = NULL;
+    if (napi_get_named_property(env, args[0], wide_struct_fields[i], &element) != napi_ok) {
+      return undefined_value(env);
+    }
+    int32_t value = 0;
+    if (napi_get_value_int32(env, element, &value) != napi_ok) return undefined_value(env);
+    total += value;
+  }
+  return create_int32(env, total);
+}
+
+static napi_value napi_wide_struct_make(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!get_args(env, info, 1, args)) return undefined_value(env);
+
+  int32_t seed = 0;
+  if (napi_get_value_int32(env, args[0], &seed) != napi_ok) return undefined_value(env);
+
+  napi_value result = NULL;
+  if (napi_create_object(env, &result) != napi_ok) return undefined_value(env);
+  for (size_t i = 0; i < WIDE_STRUCT_FIELD_COUNT; i++) {
+    napi_value field = create_int32(env, seed + (int32_t)i);
+    if (napi_set_named_property(env, result, wide_struct_fields[i], field) != napi_ok) {
+      return undefined_value(env);
+    }
+  }
+  return result;
+}
+
 static napi_value napi_array_sum(napi_env env, napi_callback_info info) {
   napi_value args[1];
   if (!get_args(env, info, 1, args)) return undefined_value(env);
@@ -137,6 +179,94 @@ static napi_value napi_array_sum(napi_env env, napi_callback_info info) {
   return create_double(env, total);
 }
 
+static napi_value napi_string_copy_len(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!get_args(env, info, 1, args)) return undefined_value(env);
+
+  size_t len = 0;
+  if (napi_get_value_string_utf8(env, args[0], NULL, 0, &len) != napi_ok) {
+    return undefined_value(env);
+  }
+
+  char* bytes = (char*)malloc(len + 1);
+  if (bytes == NULL) return undefined_value(env);
+  size_t copied = 0;
+  if (napi_get_value_string_utf8(env, args[0], bytes, len + 1, &copied) != napi_ok) {
+    free(bytes);
+    return undefined_value(env);
+  }
+  free(bytes);
+  return create_uint32(env, (uint32_t)copied);
+}
+
+static napi_value napi_slice_sum(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!get_args(env, info, 1, args)) return undefined_value(env);
+
+  uint32_t len = 0;
+  if (napi_get_array_length(env, args[0], &len) != napi_ok) return undefined_value(env);
+
+  double* values = (double*)malloc(sizeof(double) * (len == 0 ? 1 : len));
+  if (values == NULL) return undefined_value(env);
+  for (uint32_t i = 0; i < len; i++) {
+    napi_value element = NULL;
+    if (napi_get_element(env, args[0], i, &element) != napi_ok ||
+        napi_get_value_double(env, element, &values[i]) != napi_ok) {
+      free(values);
+      return undefined_value(env);
+    }
+  }
+
+  double total = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    total += values[i];
+  }
+  free(values);
+  return create_double(env, total);
+}
+
+static napi_value napi_string_list_len(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!get_args(env, info, 1, args)) return undefined_value(env);
+
+  uint32_t len = 0;
+  if (napi_get_array_length(env, args[0], &len) != napi_ok) return undefined_value(env);
+
+  char** values = (char**)calloc(len == 0 ? 1 : len, sizeof(char*));
+  size_t* lengths = (size_t*)calloc(len == 0 ? 1 : len, sizeof(size_t));
+  napi_value result = NULL;
+  if (values == NULL || lengths == NULL) goto done;
+
+  for (uint32_t i = 0; i < len; i++) {
+    napi_value element = NULL;
+    if (napi_get_element(env, args[0], i, &element) != napi_ok ||
+        napi_get_value_string_utf8(env, element, NULL, 0, &lengths[i]) != napi_ok) {
+      goto done;
+    }
+    values[i] = (char*)malloc(lengths[i] + 1);
+    if (values[i] == NULL ||
+        napi_get_value_string_utf8(env, element, values[i], lengths[i] + 1, &lengths[i]) != napi_ok) {
+      goto done;
+    }
+  }
+
+  size_t total = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    total += lengths[i];
+  }
+  result = create_uint32(env, (uint32_t)total);
+
+done:
+  if (values != NULL) {
+    for (uint32_t i = 0; i < len; i++) {
+      free(values[i]);
+    }
+  }
+  free(values);
+  free(lengths);
+  return result == NULL ? undefined_value(env) : result;
+}
+
 static napi_value napi_call_function_bench(napi_env env, napi_callback_info info) {
   napi_value args[1];
   if (!get_args(env, info, 1, args)) return undefined_value(env);
@@ -239,6 +369,28 @@ static napi_value napi_uint8array_sum(napi_env env, napi_callback_info info) {
   return create_uint32(env, total);
 }
 
+static napi_value napi_float64array_sum(napi_env env, napi_callback_info info) {
+  napi_value args[1];
+  if (!get_args(env, info, 1, args)) return undefined_value(env);
+
+  napi_typedarray_type type;
+  size_t len = 0;
+  void* data = NULL;
+  napi_value arraybuffer = NULL;
+  size_t byte_offset = 0;
+  if (napi_get_typedarray_info(env, args[0], &type, &len, &data, &arraybuffer, &byte_offset) != napi_ok) {
+    return undefined_value(env);
+  }
+  if (data == NULL || type != napi_float64_array) return undefined_value(env);
+
+  const double* values = (const double*)data;
+  double total = 0;
+  for (size_t i = 0; i < len; i++) {
+    total += values[i];
+  }
+  return create_double(env, total);
+}
+
 static napi_value napi_new_dataview(napi_env env, napi_callback_info info) {
   napi_value args[1];
   if (!get_args(env, info, 1, args)) return undefined_value(env);
@@ -369,7 +521,12 @@ static napi_value init(napi_env env, napi_value exports) {
   define_function(env, exports, "napi_bool_identity", napi_bool_identity);
   define_function(env, exports, "napi_string_len", napi_string_len);
   define_function(env, exports, "napi_object_read", napi_object_read);
+  define_function(env, exports, "napi_wide_struct_sum", napi_wide_struct_sum);
+  define_function(env, exports, "napi_wide_struct_make", napi_wide_struct_make);
   define_function(env, exports, "napi_array_sum", napi_array_sum);
+  define_function(env, exports, "napi_string_copy_len", napi_string_copy_len);
+  define_function(env, exports, "napi_slice_sum", napi_slice_sum);
+  define_function(env, exports, "napi_string_list_len", napi_string_list_len);
   define_function(env, exports, "napi_call_function", napi_call_function_bench);
   define_function(env, exports, "napi_new_arraybuffer", napi_new_arraybuffer);
   define_function(env, exports, "napi_arraybuffer_length", napi_arraybuffer_length);
@@ -377,6 +534,7 @@ static napi_value init(napi_env env, napi_value exports) {
   define_function(env, exports, "napi_buffer_length", napi_buffer_length);
   define_function(env, exports, "napi_new_uint8array", napi_new_uint8array);
   define_function(env, exports, "napi_uint8array_sum", napi_uint8array_sum);
+  define_function(env, exports, "napi_float64array_sum", napi_float64array_sum);
   define_function(env, exports, "napi_new_dataview", napi_new_dataview);
   define_function(env, exports, "napi_dataview_length", napi_dataview_length);
   define_class(env, exports);
@@ -1,12 +1,21 @@
 declare function requireNapiPreview(name: string, isApp: boolean): ESObject;
 declare function print(message: string): void;
+declare function setInterval(callback: () => void, delay: number): number;
+declare function clearInterval(id: number): void;
 
 const RESULT_PREFIX = "__ZIG_NAPI_BENCHMARK_RESULT__";
 const DEFAULT_ITERATIONS = 100000;
 const HEAVY_ITERATIONS = 20000;
+const LARGE_INPUT_ITERATIONS = 1000;
 const WARMUP_ITERATIONS = 2000;
+const PARALLEL_ITERATIONS = 100;
+const PARALLEL_WARMUP_ITERATIONS = 10;
+const PARALLEL_LENGTH = 1 << 20;
+const PARALLEL_WORKERS = [1, 2, 4, 8];
+const KEEP_ALIVE_INTERVAL_MS = 10;
 
 type BenchFn = () => ESObject;
+type AsyncBenchFn = () => Promise<ESObject>;
 type CallbackInput = (left: number, right: number) => ESObject;
 
 let blackhole: ESObject = undefined;
@@ -29,6 +38,42 @@ function runOne(fn: BenchFn, iterations: number, nowUs: () => number): number {
   return (end - start) / iterations;
 }
 
+async function runOneAsync(fn: AsyncBenchFn, iterations: number, nowUs: () => number): Promise<number> {
+  const warmup = Math.min(PARALLEL_WARMUP_ITERATIONS, iterations);
+  for (let i = 0; i < warmup; i++) {
+    blackhole = await fn();
+  }
+
+  const start = nowUs();
+  for (let i = 0; i < iterations; i++) {
+    blackhole = await fn();
+  }
+  const end = nowUs();
+  return (end - start) / iterations;
+}
+
+// Same timer runtime as test/native.ts: ark_js_napi_cli only keeps running
+// while a uv handle is alive, and the async rows need the loop.
+function installTimerGlobals() {
+  const etsInterop = requireNapiPreview("ets_interop_js_napi", true) as ESObject;
+  const created = etsInterop.createRuntime({
+    "panda-files": "./hello.abc",
+    "boot-panda-files": "./etsstdlib.abc:./hello.abc",
+    "xgc-trigger-type": "never",
+  });
+  if (!created) {
+    throw new Error("failed to initialize ArkVM timer runtime");
+  }
+}
+
+function makeParallelInput(): Float64Array {
+  const values = new Float64Array(PARALLEL_LENGTH);
+  for (let i = 0; i < values.length; i++) {
+    values[i] = i % 1024;
+  }
+  return values;
+}
+
 function printRow(
   moduleName: string,
   apiContent: string,
@@ -51,6 +96,22 @@ function ensureEqual(actual: ESObject, expected: ESObject, label: string) {
   }
 }
 
+function makeWideInput(): ESObject {
+  const value: ESObject = {};
+  for (let i = 0; i < 16; i++) {
+    value[`f${i}`] = i;
+  }
+  return value;
+}
+
+function makeStringList(count: number): string[] {
+  const values: string[] = [];
+  for (let i = 0; i < count; i++) {
+    values.push(`item-${i}`);
+  }
+  return values;
+}
+
 function validateNative(
   zig: ESObject,
   napi: ESObject,
@@ -72,10 +133,30 @@ function validateNative(
     "OpenHarmony ArkVM".length,
     "native N-API string len",
   );
+  ensureEqual(
+    zig.zig_string_copy_len("OpenHarmony ArkVM"),
+    "OpenHarmony ArkVM".length,
+    "zig string copy len",
+  );
+  ensureEqual(
+    napi.napi_string_copy_len("OpenHarmony ArkVM"),
+    "OpenHarmony ArkVM".length,
+    "native N-API string copy len",
+  );
   ensureEqual(zig.zig_object_read(objectInput), 42, "zig object read");
   ensureEqual(napi.napi_object_read(objectInput), 42, "native N-API object read");
+  const wideInput = makeWideInput();
+  ensureEqual(zig.zig_wide_struct_sum(wideInput), 120, "zig wide struct read");
+  ensureEqual(napi.napi_wide_struct_sum(wideInput), 120, "native N-API wide struct read");
+  ensureEqual(zig.zig_wide_struct_make(1).f15, 16, "zig wide struct write");
+  ensureEqual(napi.napi_wide_struct_make(1).f15, 16, "native N-API wide struct write");
   ensureEqual(zig.zig_array_sum(arrayInput), 36, "zig array sum");
   ensureEqual(napi.napi_array_sum(arrayInput), 36, "native N-API array sum");
+  ensureEqual(zig.zig_slice_sum(arrayInput), 36, "zig slice sum");
+  ensureEqual(napi.napi_slice_sum(arrayInput), 36, "native N-API slice sum");
+  const stringList = makeStringList(4);
+  ensureEqual(zig.zig_string_list_len(stringList), 24, "zig string list len");
+  ensureEqual(napi.napi_string_list_len(stringList), 24, "native N-API string list len");
   ensureEqual(zig.zig_call_function(callbackInput), 42, "zig callback");
   ensureEqual(napi.napi_call_function(callbackInput), 42, "native N-API callback");
 
@@ -87,6 +168,11 @@ function validateNative(
   napiClass.value = 7;
   ensureEqual(zigClass.add(1), 8, "zig class method");
   ensureEqual(napiClass.add(1), 8, "native N-API class method");
+  const zigSharedClass = new zig.ZigSharedBenchClass(1);
+  ensureEqual(zigSharedClass.value, 1, "zig shared class getter");
+  zigSharedClass.value = 7;
+  ensureEqual(zigSharedClass.add(1), 8, "zig shared class method");
+  ensureEqual(zigSharedClass.value, 8, "zig shared class getter after method");
 
   ensureEqual(zig.zig_arraybuffer_length(zig.zig_new_arraybuffer(16)), 16, "zig arraybuffer");
   ensureEqual(
@@ -110,17 +196,28 @@ function validateNative(
   ensureEqual(napi.napi_dataview_length(napi.napi_new_dataview(16)), 16, "native N-API dataview");
 }
 
-function main() {
+async function main() {
   const zig = requireNapiPreview("zig_benchmark", true) as ESObject;
   const napi = requireNapiPreview("napi_benchmark", true) as ESObject;
   const nowUs = () => napi.bench_now_us() as number;
 
   const objectInput = { count: 41, flag: true };
+  const wideInput = makeWideInput();
   const arrayInput = [1, 2, 3, 4, 5, 6, 7, 8];
+  const stringListInput = makeStringList(10000);
   const callbackInput = (left: number, right: number): ESObject => left + right;
   validateNative(zig, napi, objectInput, arrayInput, callbackInput);
+  const parallelInput = makeParallelInput();
+  const parallelSum = (PARALLEL_LENGTH / 1024) * ((1023 * 1024) / 2);
+  ensureEqual(napi.napi_float64array_sum(parallelInput), parallelSum, "native N-API float64 sum");
+  ensureEqual(
+    await zig.zig_float64array_sum_parallel(parallelInput, 2),
+    parallelSum,
+    "zig parallel float64 sum",
+  );
 
   const zigClass = new zig.ZigBenchClass(1);
+  const zigSharedClass = new zig.ZigSharedBenchClass(1);
   const napiClass = new napi.NapiBenchClass(1);
   const zigArrayBuffer = zig.zig_new_arraybuffer(16);
   const napiArrayBuffer = napi.napi_new_arraybuffer(16);
@@ -155,18 +252,49 @@ function main() {
       zig: () => zig.zig_string_len("OpenHarmony ArkVM"),
       napi: () => napi.napi_string_len("OpenHarmony ArkVM"),
     },
+    {
+      moduleName: "string",
+      apiContent: "copy([]const u8)",
+      zig: () => zig.zig_string_copy_len("OpenHarmony ArkVM"),
+      napi: () => napi.napi_string_copy_len("OpenHarmony ArkVM"),
+    },
     {
       moduleName: "object",
       apiContent: "read properties",
       zig: () => zig.zig_object_read(objectInput),
       napi: () => napi.napi_object_read(objectInput),
     },
+    {
+      moduleName: "object",
+      apiContent: "read 16-field struct",
+      zig: () => zig.zig_wide_struct_sum(wideInput),
+      napi: () => napi.napi_wide_struct_sum(wideInput),
+    },
+    {
+      moduleName: "object",
+      apiContent: "write 16-field struct",
+      zig: () => zig.zig_wide_struct_make(1),
+      napi: () => napi.napi_wide_struct_make(1),
+    },
     {
       moduleName: "array",
       apiContent: "sum(number[])",
       zig: () => zig.zig_array_sum(arrayInput),
       napi: () => napi.napi_array_sum(arrayInput),
     },
+    {
+      moduleName: "array",
+      apiContent: "sum([]const f64)",
+      zig: () => zig.zig_slice_sum(arrayInput),
+      napi: () => napi.napi_slice_sum(arrayInput),
+    },
+    {
+      moduleName: "array",
+      apiContent: "ArrayList([]const u8) x10000",
+      iterations: LARGE_INPUT_ITERATIONS,
+      zig: () => zig.zig_string_list_len(stringListInput),
+      napi: () => napi.napi_string_list_len(stringListInput),
+    },
     {
       moduleName: "function",
       apiContent: "call callback",
@@ -204,6 +332,31 @@ function main() {
       zig: () => zigClass.add(1),
       napi: () => napiClass.add(1),
     },
+    {
+      moduleName: "class",
+      apiContent: "shared constructor",
+      iterations: HEAVY_ITERATIONS,
+      zig: () => new zig.ZigSharedBenchClass(1),
+      napi: () => new napi.NapiBenchClass(1),
+    },
+    {
+      moduleName: "class",
+      apiContent: "shared getter",
+      zig: () => zigSharedClass.value,
+      napi: () => napiClass.value,
+    },
+    {
+      moduleName: "class",
+      apiContent: "shared setter",
+      zig: () => {
+        zigSharedClass.value = 7;
+        return zigSharedClass.value;
+      },
+      napi: () => {
+        napiClass.value = 7;
+        return napiClass.value;
+      },
+    },
     {
       moduleName: "ArrayBuffer",
       apiContent: "constructor",
@@ -272,16 +425,53 @@ function main() {
     printRow(item.moduleName as string, item.apiContent as string, iterations, napiUs, zigUs);
   }
 
+  // One native call sums on the JS thread; the zig-napi side resolves an
+  // AsyncParallel promise, so the ratio column shows scaling with workers.
+  const sequentialUs = runOne(
+    () => napi.napi_float64array_sum(parallelInput),
+    PARALLEL_ITERATIONS,
+    nowUs,
+  );
+  for (let i = 0; i < PARALLEL_WORKERS.length; i++) {
+    const workers = PARALLEL_WORKERS[i];
+    const zigUs = await runOneAsync(
+      () => zig.zig_float64array_sum_parallel(parallelInput, workers),
+      PARALLEL_ITERATIONS,
+      nowUs,
+    );
+    printRow(
+      "AsyncParallel",
+      `Float64Array sum x1M, ${workers} workers`,
+      PARALLEL_ITERATIONS,
+      sequentialUs,
+      zigUs,
+    );
+  }
+
   if (blackhole === null) {
     print("__ZIG_NAPI_BENCHMARK_BLACKHOLE__ null");
   }
-  print(`${RESULT_PREFIX} status=ok`);
 }
 
-try {
-  main();
-} catch (err) {
-  const message = String(err && (err.message || err));
-  print(`${RESULT_PREFIX} status=fail message=${message}`);
-  throw err;
-}
+installTimerGlobals();
+let finished = false;
+const keepAlive = setInterval(() => {
+  if (finished) {
+    clearInterval(keepAlive);
+  }
+}, KEEP_ALIVE_INTERVAL_MS);
+
+main().then(
+  () => {
+    finished = true;
+    clearInterval(keepAlive);
+    print(`${RESULT_PREFIX} status=ok`);
+  },
+  (err) => {
+    finished = true;
+    clearInterval(keepAlive);
+    const message = String(err && (err.message || err));
+    print(`${RESULT_PREFIX} status=fail message=${message}`);
+    throw err;
+  },
+);
@@ -1,7 +1,7 @@
 const napi = @import("napi");
 
 pub fn allocator_kind() []const u8 {
-    return "builtin-page";
+    return "builtin-smp";
 }
 
 pub fn manual_allocation_roundtrip(len: u32) bool {
@@ -74,6 +74,25 @@ export interface NullableField {
   name?: string;
 }
 
+export interface WideField {
+  f0: number;
+  f1: number;
+  f2: number;
+  f3: number;
+  f4: number;
+  f5: number;
+  f6: number;
+  f7: number;
+  f8: number;
+  f9: number;
+  f10: number;
+  f11: number;
+  f12: number;
+  f13: number;
+  f14: number;
+  f15: number;
+}
+
 export interface Object {
   env?: unknown;
   raw?: unknown;
@@ -107,6 +126,17 @@ export declare class TestFactoryClass {
   format(): string;
 }
 
+export declare class Vec3Class {
+  constructor(x: number, y: number, z: number);
+  x: number;
+  y: number;
+  z: number;
+  id: number;
+  visible: boolean;
+  lengthSquared(): number;
+  scale(factor: number): void;
+}
+
 export interface MessagePayload {
   title: string;
   count: number;
@@ -134,6 +164,16 @@ export interface ExternalPoint {
   y: number;
 }
 
+export interface ThreadSafeFunctionStats {
+  enqueued: number;
+  delivered: number;
+  dropped: number;
+  depth: number;
+  max_depth: number;
+  total_latency_ns: number;
+  max_latency_ns: number;
+}
+
 export declare function test_i32(left: number, right: number): number;
 export declare function test_f32(left: number, right: number): number;
 export declare function test_u32(left: number, right: number): number;
@@ -141,6 +181,12 @@ export declare const custom_add: (left: Number, right: Number) => Number;
 export declare function hello(name: string): string;
 export declare function raw_string_len(value: string): number;
 export declare function copied_string_len(value: string): number;
+export declare function small_string_len(value: string): number;
+export declare function small_string_is_inline(value: string): boolean;
+export declare function small_string_echo(value: string): string;
+export declare function external_static_string(): string;
+export declare function external_owned_string(len: number): string;
+export declare function external_utf8_string(): string;
 export declare const text: string;
 export declare const custom_text: String;
 export declare function custom_string(name: string): String;
@@ -169,11 +215,29 @@ export declare function count_async_progress_thread(
   total: number,
   onEvent?: (event: CountProgress) => void,
 ): Promise<number>;
+export declare function count_async_latest_thread(
+  total: number,
+  onEvent?: (event: CountProgress) => void,
+): Promise<number>;
+export declare function count_async_coalesced_thread(
+  total: number,
+  onEvent?: (event: Array<CountProgress>) => void,
+): Promise<number>;
+export declare function count_async_sampled_thread(
+  total: number,
+  onEvent?: (event: CountProgress) => void,
+): Promise<number>;
 export declare function event_mode_progress_async(
   total: number,
   onEvent?: (event: CountProgress) => void,
 ): Promise<number>;
 export declare function abortable_count_async(total: number, signal: AbortSignal): Promise<number>;
+export declare function wait_for_abort_async(max_steps: number, signal: AbortSignal): Promise<number>;
+export declare function square_batch_async(
+  values: Array<number>,
+  signal: AbortSignal,
+): Promise<Uint32Array>;
+export declare function count_stream_async(total: number): Promise<AsyncIterable<CountProgress>>;
 export declare function get_and_return_array(array: Array<number>): Array<number>;
 export declare function get_named_array(
   array: [number, boolean, string],
@@ -181,6 +245,7 @@ export declare function get_named_array(
 export declare function get_arraylist(array: Array<number>): Array<number>;
 export declare function raw_array_sum(array: Array): number;
 export declare function raw_array_create(): Array;
+export declare function scoped_array_sum(array: Array): number;
 export declare function get_object(config: FullField): FullField;
 export declare function get_object_optional(config: OptionalField): OptionalField;
 export declare function get_optional_object_and_return_optional(
@@ -190,6 +255,9 @@ export declare function get_nullable_object(config: NullableField): NullableFiel
 export declare function return_nullable(): NullableField;
 export declare function raw_object_read(config: Object, key: string): number;
 export declare function raw_object_create(key: string, value: number): Object;
+export declare function wide_object_weighted_sum(value: WideField): number;
+export declare function wide_object_make(base: number): WideField;
+export declare function named_object_swap(config: Object): Object;
 export declare function call_function(cb: (arg0: number, arg1: number) => number): number;
 export declare function basic_function(left: number, right: number): number;
 export declare function create_function(): (left: number, right: number) => number;
@@ -199,6 +267,20 @@ export declare function call_function_with_reference(
 export declare function call_thread_safe_function(
   tsfn: (err: Error | null, arg0: number, arg1: number) => void,
 ): void;
+export declare function call_batched_thread_safe_function(
+  tsfn: (batch: Float64Array) => void,
+  count: number,
+): void;
+export declare function call_delayed_batched_thread_safe_function(
+  tsfn: (batch: Float64Array) => void,
+): void;
+export declare function call_observed_thread_safe_function(
+  tsfn: (arg0: number, arg1: ThreadSafeFunctionStats) => void,
+  count: number,
+): void;
+export declare function subscribe_thread_safe_function(tsfn: (arg0: number) => void): number;
+export declare function unsubscribe_thread_safe_function(tsfn: (arg0: number) => void): void;
+export declare function make_factory_instance(age: number, name: string): TestFactoryClass;
 export declare function test_hilog(): void;
 export declare function create_buffer(): Buffer;
 export declare function create_empty_buffer_new(): Buffer;
@@ -206,6 +288,8 @@ export declare function create_empty_buffer_copy(): Buffer;
 export declare function create_empty_external_buffer(): Buffer;
 export declare function get_buffer(buf: Buffer): number;
 export declare function get_buffer_as_string(buf: Buffer): string;
+export declare function borrowed_bytes_sum(bytes: Buffer | ArrayBuffer | Uint8Array): number;
+export declare function fill_buffer_index_parallel_async(buf: Buffer): Promise<void>;
 export declare function create_arraybuffer(): ArrayBuffer;
 export declare function create_empty_arraybuffer_new(): ArrayBuffer;
 export declare function create_empty_arraybuffer_copy(): ArrayBuffer;
@@ -215,6 +299,11 @@ export declare function get_arraybuffer_as_string(buf: ArrayBuffer): string;
 export declare function create_uint8_typedarray(): Uint8Array;
 export declare function get_uint8_typedarray_length(array: Uint8Array): number;
 export declare function sum_float32_typedarray(array: Float32Array): number;
+export declare function sum_float64_parallel_async(
+  array: Float64Array,
+  signal: AbortSignal,
+): Promise<number>;
+export declare function double_float32_parallel_async(array: Float32Array): Promise<void>;
 export declare function create_dataview(): DataView;
 export declare function get_dataview_length(view: DataView): number;
 export declare function get_dataview_first_byte(view: DataView): number;
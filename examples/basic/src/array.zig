@@ -37,6 +37,21 @@ pub fn raw_array_sum(array: napi.Array) f64 {
     return total;
 }
 
+pub fn scoped_array_sum(env: napi.Env, array: napi.Array) !f64 {
+    var total: f64 = 0;
+    var i: u32 = 0;
+    while (i < array.length()) {
+        const scope = try env.openHandleScope();
+        defer scope.close() catch {};
+
+        const end = @min(i + 256, array.length());
+        while (i < end) : (i += 1) {
+            total += array.Get(i, f64);
+        }
+    }
+    return total;
+}
+
 pub fn raw_array_create(env: napi.Env) !napi.Array {
     var array = try napi.Array.Create(env);
     try array.Push(@as(i32, 1));
@@ -142,6 +142,14 @@ fn count_with_progress_execute(ctx: napi.AsyncContext(CountProgress), total: u32
     return total;
 }
 
+/// Emits `total + 1` events in a burst, then keeps the task running so a
+/// held-back sampled value has to arrive without the completion flush.
+fn count_then_idle_execute(ctx: napi.AsyncContext(CountProgress), total: u32) !u32 {
+    const result = try count_with_progress_execute(ctx, total);
+    ctx.io.sleep(.fromMilliseconds(300), .awake) catch {};
+    return result;
+}
+
 fn abortable_count_execute(ctx: napi.AsyncContext(void), total: u32) !u32 {
     var current: u32 = 0;
     while (current < total) : (current += 1) {
@@ -153,6 +161,28 @@ fn abortable_count_execute(ctx: napi.AsyncContext(void), total: u32) !u32 {
     return total;
 }
 
+fn count_stream_execute(ctx: napi.AsyncContext(CountProgress), total: u32) !void {
+    var current: u32 = 0;
+    while (current < total) : (current += 1) {
+        try ctx.emit(.{ .current = current, .total = total });
+    }
+}
+
+/// Polls the cancel token between short sleeps. Abort reaches a run function
+/// only at such checks; the sleep itself is not interrupted.
+fn wait_for_abort_execute(ctx: napi.AsyncContext(void), max_steps: u32) !u32 {
+    var step: u32 = 0;
+    while (step < max_steps) : (step += 1) {
+        try ctx.checkCancelled();
+        ctx.io.sleep(.fromMilliseconds(1), .awake) catch {};
+    }
+    return step;
+}
+
+fn square_execute(value: u32) !u32 {
+    return std.math.mul(u32, value, value);
+}
+
 pub fn fib_async(n: f64) napi.Async(f64, .thread) {
     return napi.Async(f64, .thread).from(n, fibonacci_execute);
 }
@@ -189,6 +219,18 @@ pub fn count_async_progress_thread(total: u32) napi.AsyncWithEvents(u32, CountPr
     return napi.AsyncWithEvents(u32, CountProgress, .thread).from(total, count_with_progress_execute);
 }
 
+pub fn count_async_latest_thread(total: u32) napi.AsyncWithEventPolicy(u32, CountProgress, .thread, .latest) {
+    return napi.AsyncWithEventPolicy(u32, CountProgress, .thread, .latest).from(total, count_with_progress_execute);
+}
+
+pub fn count_async_coalesced_thread(total: u32) napi.AsyncWithEventPolicy(u32, CountProgress, .thread, .{ .coalesce = 64 }) {
+    return napi.AsyncWithEventPolicy(u32, CountProgress, .thread, .{ .coalesce = 64 }).from(total, count_with_progress_execute);
+}
+
+pub fn count_async_sampled_thread(total: u32) napi.AsyncWithEventPolicy(u32, CountProgress, .thread, .{ .sampled = 10 }) {
+    return napi.AsyncWithEventPolicy(u32, CountProgress, .thread, .{ .sampled = 10 }).from(total, count_then_idle_execute);
+}
+
 pub fn event_mode_progress_async(total: u32) napi.AsyncWithEvents(u32, CountProgress, .event) {
     return napi.AsyncWithEvents(u32, CountProgress, .event).from(total, count_with_progress_execute);
 }
@@ -197,3 +239,17 @@ pub fn abortable_count_async(total: u32, signal: napi.AbortSignal) napi.Async(u3
     _ = signal;
     return napi.Async(u32, .thread).from(total, abortable_count_execute);
 }
+
+pub fn wait_for_abort_async(max_steps: u32, signal: napi.AbortSignal) napi.Async(u32, .thread) {
+    _ = signal;
+    return napi.Async(u32, .thread).from(max_steps, wait_for_abort_execute);
+}
+
+pub fn square_batch_async(values: []u32, signal: napi.AbortSignal) napi.AsyncBatch(u32, .thread) {
+    _ = signal;
+    return napi.AsyncBatch(u32, .thread).fromWithParallelism(values, 4, square_execute);
+}
+
+pub fn count_stream_async(total: u32) napi.AsyncStream(CountProgress, .thread) {
+    return napi.AsyncStream(CountProgress, .thread).fromWithCapacity(total, 8, count_stream_execute);
+}
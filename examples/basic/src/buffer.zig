@@ -26,3 +26,21 @@ pub fn get_buffer(buf: napi.Buffer) !usize {
 pub fn get_buffer_as_string(buf: napi.Buffer) ![]u8 {
     return buf.asSlice();
 }
+
+pub fn borrowed_bytes_sum(bytes: napi.Borrowed([]const u8)) u32 {
+    var sum: u32 = 0;
+    for (bytes.slice()) |byte| {
+        sum += byte;
+    }
+    return sum;
+}
+
+fn index_chunk(chunk: []u8, offset: usize) void {
+    for (chunk, offset..) |*byte, index| {
+        byte.* = @truncate(index);
+    }
+}
+
+pub fn fill_buffer_index_parallel_async(buf: napi.Buffer) napi.AsyncParallel(u8, void) {
+    return napi.parallelFor(buf, index_chunk);
+}
@@ -31,7 +31,36 @@ const TestFactory = struct {
     }
 };
 
+const Vec3 = struct {
+    x: f64,
+    y: f64,
+    z: f64,
+    id: u16,
+    visible: bool,
+
+    pub fn init(x: f64, y: f64, z: f64) Vec3 {
+        return .{ .x = x, .y = y, .z = z, .id = 0, .visible = true };
+    }
+
+    pub fn lengthSquared(self: *Vec3) f64 {
+        return self.x * self.x + self.y * self.y + self.z * self.z;
+    }
+
+    pub fn scale(self: *Vec3, factor: f64) void {
+        self.x *= factor;
+        self.y *= factor;
+        self.z *= factor;
+    }
+};
+
 pub const TestClass = napi.Class(Test);
 pub const TestWithInitClass = napi.Class(TestWithInit);
 pub const TestWithoutInitClass = napi.ClassWithoutInit(TestWithInit);
 pub const TestFactoryClass = napi.Class(TestFactory);
+pub const Vec3Class = napi.SharedClass(Vec3);
+
+pub fn make_factory_instance(env: napi.Env, age: i32, name: []const u8) !TestFactoryClass {
+    // Arguments only live for the call; the instance keeps its own copy.
+    const owned_name = try napi.globalAllocator().dupe(u8, name);
+    return TestFactoryClass.New(env, .{ .name = owned_name, .age = age });
+}
@@ -31,6 +31,12 @@ pub const custom_add = napi.dts(number.test_i32, "(left: Number, right: Number)
 pub const hello = string.hello;
 pub const raw_string_len = string.raw_string_len;
 pub const copied_string_len = string.copied_string_len;
+pub const small_string_len = string.small_string_len;
+pub const small_string_is_inline = string.small_string_is_inline;
+pub const small_string_echo = string.small_string_echo;
+pub const external_static_string = string.external_static_string;
+pub const external_owned_string = string.external_owned_string;
+pub const external_utf8_string = string.external_utf8_string;
 pub const text = string.text;
 pub const custom_text = string.custom_text;
 pub const custom_string = string.custom_string;
@@ -53,14 +59,21 @@ pub const async_math_single = async_examples.async_math_single;
 pub const async_void_thread = async_examples.async_void_thread;
 pub const async_fail_thread = async_examples.async_fail_thread;
 pub const count_async_progress_thread = async_examples.count_async_progress_thread;
+pub const count_async_latest_thread = async_examples.count_async_latest_thread;
+pub const count_async_coalesced_thread = async_examples.count_async_coalesced_thread;
+pub const count_async_sampled_thread = async_examples.count_async_sampled_thread;
 pub const event_mode_progress_async = async_examples.event_mode_progress_async;
 pub const abortable_count_async = async_examples.abortable_count_async;
+pub const wait_for_abort_async = async_examples.wait_for_abort_async;
+pub const square_batch_async = async_examples.square_batch_async;
+pub const count_stream_async = async_examples.count_stream_async;
 
 pub const get_and_return_array = array.get_and_return_array;
 pub const get_named_array = array.get_named_array;
 pub const get_arraylist = array.get_arraylist;
 pub const raw_array_sum = array.raw_array_sum;
 pub const raw_array_create = array.raw_array_create;
+pub const scoped_array_sum = array.scoped_array_sum;
 
 pub const get_object = object.get_object;
 pub const get_object_optional = object.get_object_optional;
@@ -69,6 +82,9 @@ pub const get_nullable_object = object.get_nullable_object;
 pub const return_nullable = object.return_nullable;
 pub const raw_object_read = object.raw_object_read;
 pub const raw_object_create = object.raw_object_create;
+pub const wide_object_weighted_sum = object.wide_object_weighted_sum;
+pub const wide_object_make = object.wide_object_make;
+pub const named_object_swap = object.named_object_swap;
 
 pub const call_function = function.call_function;
 pub const basic_function = function.basic_function;
@@ -76,11 +92,18 @@ pub const create_function = function.create_function;
 pub const call_function_with_reference = reference.call_function_with_reference;
 
 pub const call_thread_safe_function = thread_safe_function.call_thread_safe_function;
+pub const call_batched_thread_safe_function = thread_safe_function.call_batched_thread_safe_function;
+pub const call_delayed_batched_thread_safe_function = thread_safe_function.call_delayed_batched_thread_safe_function;
+pub const call_observed_thread_safe_function = thread_safe_function.call_observed_thread_safe_function;
+pub const subscribe_thread_safe_function = thread_safe_function.subscribe_thread_safe_function;
+pub const unsubscribe_thread_safe_function = thread_safe_function.unsubscribe_thread_safe_function;
 
 pub const TestClass = class.TestClass;
 pub const TestWithInitClass = class.TestWithInitClass;
 pub const TestWithoutInitClass = class.TestWithoutInitClass;
 pub const TestFactoryClass = class.TestFactoryClass;
+pub const make_factory_instance = class.make_factory_instance;
+pub const Vec3Class = class.Vec3Class;
 
 pub const test_hilog = log.test_hilog;
 
@@ -90,6 +113,8 @@ pub const create_empty_buffer_copy = buffer.create_empty_buffer_copy;
 pub const create_empty_external_buffer = buffer.create_empty_external_buffer;
 pub const get_buffer = buffer.get_buffer;
 pub const get_buffer_as_string = buffer.get_buffer_as_string;
+pub const borrowed_bytes_sum = buffer.borrowed_bytes_sum;
+pub const fill_buffer_index_parallel_async = buffer.fill_buffer_index_parallel_async;
 
 pub const create_arraybuffer = arraybuffer.create_arraybuffer;
 pub const create_empty_arraybuffer_new = arraybuffer.create_empty_arraybuffer_new;
@@ -101,6 +126,8 @@ pub const get_arraybuffer_as_string = arraybuffer.get_arraybuffer_as_string;
 pub const create_uint8_typedarray = typedarray.create_uint8_typedarray;
 pub const get_uint8_typedarray_length = typedarray.get_uint8_typedarray_length;
 pub const sum_float32_typedarray = typedarray.sum_float32_typedarray;
+pub const sum_float64_parallel_async = typedarray.sum_float64_parallel_async;
+pub const double_float32_parallel_async = typedarray.double_float32_parallel_async;
 
 pub const create_dataview = dataview.create_dataview;
 pub const get_dataview_length = dataview.get_dataview_length;
@@ -56,3 +56,48 @@ pub fn raw_object_create(env: napi.Env, key: napi.String, value: i32) !napi.Obje
     try object.Set(key_bytes, value);
     return object;
 }
+
+/// Wide enough that struct conversion resolves sixteen keys per call; on
+/// builds that cache property keys, calls after the first reuse them.
+const WideField = struct {
+    f0: u32,
+    f1: u32,
+    f2: u32,
+    f3: u32,
+    f4: u32,
+    f5: u32,
+    f6: u32,
+    f7: u32,
+    f8: u32,
+    f9: u32,
+    f10: u32,
+    f11: u32,
+    f12: u32,
+    f13: u32,
+    f14: u32,
+    f15: u32,
+};
+
+/// Sum of `index * field`, so a key resolved to the wrong field changes it.
+pub fn wide_object_weighted_sum(value: WideField) u32 {
+    var total: u32 = 0;
+    inline for (std.meta.fields(WideField), 0..) |field, i| {
+        total += @field(value, field.name) * i;
+    }
+    return total;
+}
+
+pub fn wide_object_make(base: u32) WideField {
+    var value: WideField = undefined;
+    inline for (std.meta.fields(WideField), 0..) |field, i| {
+        @field(value, field.name) = base + i;
+    }
+    return value;
+}
+
+pub fn named_object_swap(env: napi.Env, config: napi.Object) !napi.Object {
+    var object = try napi.Object.Create(env);
+    try object.SetNamed("left", config.GetNamed("right", i32));
+    try object.SetNamed("right", config.GetNamed("left", i32));
+    return object;
+}
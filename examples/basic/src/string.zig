@@ -20,6 +20,35 @@ pub fn copied_string_len(value: napi.String) usize {
     return bytes.len;
 }
 
+pub fn small_string_len(value: napi.SmallString(8)) usize {
+    return value.length();
+}
+
+pub fn small_string_is_inline(value: napi.SmallString(8)) bool {
+    return value.isInline();
+}
+
+pub fn small_string_echo(value: napi.SmallString(8)) napi.SmallString(8) {
+    return value;
+}
+
+const external_text = "zig-napi external string";
+
+pub fn external_static_string(env: napi.Env) !napi.String {
+    return try napi.String.external(env, external_text, null);
+}
+
+pub fn external_owned_string(env: napi.Env, len: u32) !napi.String {
+    const allocator = napi.globalAllocator();
+    const bytes = try allocator.alloc(u8, len);
+    @memset(bytes, 'z');
+    return try napi.String.external(env, bytes, allocator);
+}
+
+pub fn external_utf8_string(env: napi.Env) !napi.String {
+    return try napi.String.external(env, "caf\u{e9}", null);
+}
+
 pub const text = "Hello World";
 pub const custom_text = napi.dts(text, "String");
 
@@ -32,3 +32,82 @@ pub fn call_thread_safe_function(tsfn: *napi.ThreadSafeFunction(Args, Return, tr
 
     try tsfn.release(.Release);
 }
+
+const BatchedSamples = napi.BatchedThreadSafeFunction(f64, .{ .capacity = 256, .max_batch = 64 });
+
+fn produce_batched_samples(tsfn: *BatchedSamples, count: u32) void {
+    defer tsfn.release(.Release) catch {};
+    var i: u32 = 0;
+    while (i < count) : (i += 1) {
+        tsfn.push(@floatFromInt(i), .Blocking) catch return;
+    }
+}
+
+pub fn call_batched_thread_safe_function(tsfn: *BatchedSamples, count: u32) !void {
+    errdefer tsfn.release(.Release) catch {};
+    const worker = try std.Thread.spawn(.{}, produce_batched_samples, .{ tsfn, count });
+    worker.detach();
+}
+
+const DelayedSamples = napi.BatchedThreadSafeFunction(f64, .{
+    .capacity = 64,
+    .max_batch = 64,
+    .flush_threshold = 64,
+    .max_delay_ns = 10 * std.time.ns_per_ms,
+});
+
+fn produce_delayed_samples(tsfn: *DelayedSamples) void {
+    defer tsfn.release(.Release) catch {};
+    for (0..3) |i| {
+        tsfn.push(@floatFromInt(i), .NonBlocking) catch return;
+    }
+    // Hold the use well past the delay, so only the latency bound can
+    // deliver the items before release flushes them.
+    const io = std.Io.Threaded.global_single_threaded.io();
+    io.sleep(.fromMilliseconds(1000), .awake) catch {};
+}
+
+pub fn call_delayed_batched_thread_safe_function(tsfn: *DelayedSamples) !void {
+    errdefer tsfn.release(.Release) catch {};
+    const worker = try std.Thread.spawn(.{}, produce_delayed_samples, .{tsfn});
+    worker.detach();
+}
+
+const ObservedArgs = struct { u32, napi.ThreadSafeFunctionStats };
+const ObservedTsfn = napi.ThreadSafeFunction(ObservedArgs, void, false, 0);
+
+fn produce_observed_calls(tsfn: *ObservedTsfn, count: u32) void {
+    defer tsfn.release(.Release) catch {};
+    var i: u32 = 0;
+    while (i < count) : (i += 1) {
+        tsfn.reserve() catch return;
+        tsfn.Ok(.{ i, tsfn.stats() }, .Blocking) catch return;
+    }
+}
+
+pub fn call_observed_thread_safe_function(tsfn: *ObservedTsfn, count: u32) !void {
+    errdefer tsfn.release(.Release) catch {};
+    try tsfn.setBackpressure(.{
+        .high_watermark = 16,
+        .low_watermark = 4,
+        .io = std.Io.Threaded.global_single_threaded.io(),
+    });
+    const worker = try std.Thread.spawn(.{}, produce_observed_calls, .{ tsfn, count });
+    worker.detach();
+}
+
+const SubscriberTsfn = napi.ThreadSafeFunction(struct { i32 }, void, false, 0);
+
+/// Keeps the use taken by the conversion, queues one call and returns how
+/// many calls this TSFN has queued so far. The count grows across
+/// subscriptions of the same JS function because they share one instance.
+pub fn subscribe_thread_safe_function(tsfn: *SubscriberTsfn) !u32 {
+    try tsfn.Ok(.{0}, .NonBlocking);
+    return @intCast(tsfn.stats().enqueued);
+}
+
+/// Gives back the use taken by this call and the one kept by a subscribe.
+pub fn unsubscribe_thread_safe_function(tsfn: *SubscriberTsfn) !void {
+    try tsfn.release(.Release);
+    try tsfn.release(.Release);
+}
@@ -15,3 +15,30 @@ pub fn sum_float32_typedarray(array: napi.Float32Array) f32 {
     }
     return sum;
 }
+
+fn sum_chunk(chunk: []f64, _: usize) f64 {
+    var sum: f64 = 0;
+    for (chunk) |item| {
+        sum += item;
+    }
+    return sum;
+}
+
+fn add_sums(left: f64, right: f64) f64 {
+    return left + right;
+}
+
+pub fn sum_float64_parallel_async(array: napi.Float64Array, signal: napi.AbortSignal) napi.AsyncParallel(f64, f64) {
+    _ = signal;
+    return napi.AsyncParallel(f64, f64).fromWithReduce(array, sum_chunk, add_sums);
+}
+
+fn double_chunk(chunk: []f32, _: usize) void {
+    for (chunk) |*item| {
+        item.* *= 2;
+    }
+}
+
+pub fn double_float32_parallel_async(array: napi.Float32Array) napi.AsyncParallel(f32, void) {
+    return napi.parallelFor(array, double_chunk);
+}
@@ -1,3 +1,4 @@
+const std = @import("std");
 const napi = @import("napi");
 
 const ZigBenchData = struct {
@@ -14,6 +15,7 @@ const ZigBenchData = struct {
 };
 
 pub const ZigBenchClass = napi.Class(ZigBenchData);
+pub const ZigSharedBenchClass = napi.SharedClass(ZigBenchData);
 
 pub fn zig_noop() void {}
 
@@ -29,12 +31,51 @@ pub fn zig_string_len(value: napi.String) usize {
     return value.utf8Len();
 }
 
+pub fn zig_string_copy_len(value: []const u8) usize {
+    return value.len;
+}
+
 pub fn zig_object_read(value: napi.Object) i32 {
     const count = value.GetNamed("count", i32);
     const flag = value.GetNamed("flag", bool);
     return count + if (flag) @as(i32, 1) else 0;
 }
 
+const ZigWideStruct = struct {
+    f0: i32,
+    f1: i32,
+    f2: i32,
+    f3: i32,
+    f4: i32,
+    f5: i32,
+    f6: i32,
+    f7: i32,
+    f8: i32,
+    f9: i32,
+    f10: i32,
+    f11: i32,
+    f12: i32,
+    f13: i32,
+    f14: i32,
+    f15: i32,
+};
+
+pub fn zig_wide_struct_sum(value: ZigWideStruct) i32 {
+    var total: i32 = 0;
+    inline for (@typeInfo(ZigWideStruct).@"struct".fields) |field| {
+        total += @field(value, field.name);
+    }
+    return total;
+}
+
+pub fn zig_wide_struct_make(seed: i32) ZigWideStruct {
+    var result: ZigWideStruct = undefined;
+    inline for (@typeInfo(ZigWideStruct).@"struct".fields, 0..) |field, i| {
+        @field(result, field.name) = seed + @as(i32, i);
+    }
+    return result;
+}
+
 pub fn zig_array_sum(values: napi.Array) f64 {
     var total: f64 = 0;
     for (0..values.length()) |i| {
@@ -43,6 +84,22 @@ pub fn zig_array_sum(values: napi.Array) f64 {
     return total;
 }
 
+pub fn zig_slice_sum(values: []const f64) f64 {
+    var total: f64 = 0;
+    for (values) |value| {
+        total += value;
+    }
+    return total;
+}
+
+pub fn zig_string_list_len(values: std.ArrayList([]const u8)) usize {
+    var total: usize = 0;
+    for (values.items) |value| {
+        total += value.len;
+    }
+    return total;
+}
+
 pub fn zig_call_function(cb: napi.Function(struct { i32, i32 }, i32)) !i32 {
     return try cb.Call(.{ 19, 23 });
 }
@@ -75,6 +132,22 @@ pub fn zig_uint8array_sum(value: napi.Uint8Array) usize {
     return total;
 }
 
+fn zig_float64_chunk_sum(chunk: []f64, _: usize) f64 {
+    var total: f64 = 0;
+    for (chunk) |item| {
+        total += item;
+    }
+    return total;
+}
+
+fn zig_add_f64(left: f64, right: f64) f64 {
+    return left + right;
+}
+
+pub fn zig_float64array_sum_parallel(value: napi.Float64Array, workers: u32) napi.AsyncParallel(f64, f64) {
+    return napi.AsyncParallel(f64, f64).fromWithParallelism(value, workers, zig_float64_chunk_sum, zig_add_f64);
+}
+
 pub fn zig_new_dataview(env: napi.Env, len: u32) !napi.DataView {
     return try napi.DataView.New(env, len);
 }
@@ -0,0 +1,27 @@
+const { parentPort } = require("worker_threads");
+const bindings = require("./binding");
+
+const uncaught = [];
+process.on("uncaughtException", (error) => {
+  uncaught.push(error.message);
+});
+
+async function main() {
+  const events = [0, 0, 0, 0];
+  const results = await Promise.all(
+    events.map((_, id) =>
+      bindings.asyncCountProgressThread(100, () => {
+        events[id] += 1;
+        if (id === 0 && events[id] === 1) {
+          throw new Error("listener failed");
+        }
+      }),
+    ),
+  );
+
+  parentPort.postMessage({ results, events, uncaught });
+}
+
+main().catch((error) => {
+  throw error;
+});
@@ -0,0 +1,17 @@
+const path = require("path");
+const { Worker } = require("worker_threads");
+const test = require("ava");
+
+test("a throwing listener is reported without stalling other operations", async (t) => {
+  // The uncaught exception is observed inside a worker, so it does not reach
+  // the test runner's own handler.
+  const worker = new Worker(path.join(__dirname, "async-listener.js"));
+  const message = await new Promise((resolve, reject) => {
+    worker.once("message", resolve);
+    worker.once("error", reject);
+  });
+
+  t.deepEqual(message.results, [100, 100, 100, 100]);
+  t.deepEqual(message.events, [100, 100, 100, 100]);
+  t.deepEqual(message.uncaught, ["listener failed"]);
+});
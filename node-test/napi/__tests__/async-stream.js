@@ -0,0 +1,17 @@
+const { parentPort } = require("worker_threads");
+const bindings = require("./binding");
+
+async function main() {
+  const stream = await bindings.asyncCountStreamThread(1000);
+  const iterator = stream[Symbol.asyncIterator]();
+  const first = await iterator.next();
+
+  // Keep the iterator reachable but stop pulling: the producer parks on its
+  // full buffer and must not keep the worker alive.
+  globalThis.parkedIterator = iterator;
+  parentPort.postMessage({ first: first.value.current });
+}
+
+main().catch((error) => {
+  throw error;
+});
@@ -0,0 +1,26 @@
+const path = require("path");
+const { Worker } = require("worker_threads");
+const test = require("ava");
+
+test("a stream parked on a full buffer does not keep the event loop alive", async (t) => {
+  const worker = new Worker(path.join(__dirname, "async-stream.js"));
+  const exited = new Promise((resolve, reject) => {
+    worker.once("exit", resolve);
+    worker.once("error", reject);
+  });
+  const message = await new Promise((resolve, reject) => {
+    worker.once("message", resolve);
+    worker.once("error", reject);
+  });
+  t.is(message.first, 0);
+
+  let timer;
+  const timeout = new Promise((resolve) => {
+    timer = setTimeout(() => resolve("timeout"), 5000);
+  });
+  const result = await Promise.race([exited, timeout]);
+  clearTimeout(timer);
+  if (result === "timeout") await worker.terminate();
+
+  t.is(result, 0);
+});
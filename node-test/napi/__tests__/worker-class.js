@@ -0,0 +1,23 @@
+const { parentPort, workerData } = require("worker_threads");
+const bindings = require("./binding");
+
+async function main() {
+  let total = 0;
+  for (let i = 0; i < workerData.iterations; i += 1) {
+    const counter = bindings.CounterClass.initWithFactory(`w${workerData.id}`, i);
+    if (!(counter instanceof bindings.CounterClass)) {
+      throw new Error("factory result is not a CounterClass instance");
+    }
+    total += counter.next();
+  }
+
+  parentPort.postMessage({
+    total,
+    kind: bindings.CounterClass.kind,
+    async: await bindings.asyncPlus100Thread(workerData.id),
+  });
+}
+
+main().catch((error) => {
+  throw error;
+});
@@ -0,0 +1,34 @@
+const path = require("path");
+const { Worker } = require("worker_threads");
+const test = require("ava");
+
+const bindings = require("./binding");
+
+function runWorker(id, iterations) {
+  const worker = new Worker(path.join(__dirname, "worker-class.js"), {
+    workerData: { id, iterations },
+  });
+  return new Promise((resolve, reject) => {
+    worker.once("message", resolve);
+    worker.once("error", reject);
+  });
+}
+
+test("classes and the thread runtime keep per-env state across workers", async (t) => {
+  const iterations = 1000;
+  const expectedTotal = (iterations * (iterations + 1)) / 2;
+
+  const messages = await Promise.all([0, 1, 2, 3].map((id) => runWorker(id, iterations)));
+  messages.forEach((message, id) => {
+    t.is(message.total, expectedTotal);
+    t.is(message.kind, "counter");
+    t.is(message.async, id + 100);
+  });
+
+  // Worker teardown must not release the main env's constructor or thread pool.
+  const counter = bindings.CounterClass.initWithFactory("main", 1);
+  t.true(counter instanceof bindings.CounterClass);
+  t.is(counter.next(), 2);
+  t.is(bindings.CounterClass.kind, "counter");
+  t.is(await bindings.asyncPlus100Thread(7), 107);
+});
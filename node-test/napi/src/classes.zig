@@ -0,0 +1,56 @@
+const napi = @import("napi");
+
+const Counter = struct {
+    label: []u8,
+    count: i32,
+
+    pub const kind = "counter";
+
+    const Self = @This();
+
+    pub fn initWithFactory(label: []u8, count: i32) Self {
+        return Self{ .label = label, .count = count };
+    }
+
+    pub fn next(self: *Self) i32 {
+        self.count += 1;
+        return self.count;
+    }
+};
+
+pub const CounterClass = napi.Class(Counter);
+
+fn plus100(input: i32) i32 {
+    return input + 100;
+}
+
+pub fn asyncPlus100Thread(value: i32) napi.Async(i32, .thread) {
+    return napi.Async(i32, .thread).from(value, plus100);
+}
+
+pub const CountProgress = struct {
+    current: u32,
+};
+
+fn countWithProgress(ctx: napi.AsyncContext(CountProgress), total: u32) !u32 {
+    var current: u32 = 0;
+    while (current < total) : (current += 1) {
+        try ctx.emit(.{ .current = current });
+    }
+    return total;
+}
+
+pub fn asyncCountProgressThread(total: u32) napi.AsyncWithEvents(u32, CountProgress, .thread) {
+    return napi.AsyncWithEvents(u32, CountProgress, .thread).from(total, countWithProgress);
+}
+
+fn countStream(ctx: napi.AsyncContext(CountProgress), total: u32) !void {
+    var current: u32 = 0;
+    while (current < total) : (current += 1) {
+        try ctx.emit(.{ .current = current });
+    }
+}
+
+pub fn asyncCountStreamThread(total: u32) napi.AsyncStream(CountProgress, .thread) {
+    return napi.AsyncStream(CountProgress, .thread).fromWithCapacity(total, 4, countStream);
+}
@@ -3,10 +3,12 @@ const napi = @import("napi");
 const values = @import("values.zig");
 const strict = @import("strict.zig");
 const threadsafe_function = @import("threadsafe_function.zig");
+const classes = @import("classes.zig");
 
 pub const DEFAULT_COST = values.DEFAULT_COST;
 pub const Kind = values.Kind;
 pub const CustomNumEnum = values.CustomNumEnum;
+pub const CounterClass = classes.CounterClass;
 pub const KindInValidate = strict.KindInValidate;
 pub const StatusInValidate = strict.StatusInValidate;
 
@@ -132,6 +134,9 @@ pub const resetDetachedExternalDeinitCount = values.resetDetachedExternalDeinitC
 pub const detachedExternalDeinitCount = values.detachedExternalDeinitCount;
 pub const deinitDetachedExternal = values.deinitDetachedExternal;
 pub const callThreadsafeFunction = threadsafe_function.callThreadsafeFunction;
+pub const asyncPlus100Thread = classes.asyncPlus100Thread;
+pub const asyncCountProgressThread = classes.asyncCountProgressThread;
+pub const asyncCountStreamThread = classes.asyncCountStreamThread;
 
 pub const validateArray = strict.validateArray;
 pub const validateTypedArray = strict.validateTypedArray;
@@ -167,6 +167,21 @@ pub const NodeApiOptions = struct {
     }
 };
 
+/// Defaults for the shared pool behind `.thread` async operations. The addon
+/// can still override them at startup with `napi.configureAsyncRuntime`.
+pub const AsyncRuntimeOptions = struct {
+    /// Operations running at once; further ones wait in a FIFO queue. 0 means
+    /// one pool thread per in-flight operation.
+    workers: u32 = 0,
+    /// Stack size of pool threads in bytes. 0 keeps the std default.
+    stack_size: u64 = 0,
+    /// CPUs pool threads may run on, one bit per CPU. 0 leaves the affinity
+    /// alone. Applied on Linux and OpenHarmony only.
+    affinity_mask: u64 = 0,
+    /// Start the workers together with the pool instead of on first use.
+    warm_start: bool = false,
+};
+
 fn nodePlatform(target: std.Target) []const u8 {
     return switch (target.os.tag) {
         .macos => "darwin",
@@ -251,6 +266,7 @@ pub const NativeAddonBuildOptionsWithModule = struct {
     name: []const u8,
     napi_module: ?*std.Build.Module = null,
     node_api: NodeApiOptions = .{},
+    async_runtime: AsyncRuntimeOptions = .{},
     root_module_options: std.Build.Module.CreateOptions,
     version: ?std.SemanticVersion = null,
     max_rss: usize = 0,
@@ -283,6 +299,7 @@ pub const NodeAddonBuildOptionsWithModule = struct {
     napi_module: *std.Build.Module,
     root_module_options: std.Build.Module.CreateOptions,
     node_api: NodeApiOptions = .{},
+    async_runtime: AsyncRuntimeOptions = .{},
     /// Optional Windows import library override.
     /// MSVC follows napi-rs and does not require this by default. GNU follows
     /// napi-rs' `LIBNODE_PATH`/`LIBPATH`/`PATH` libnode.dll search.
@@ -310,6 +327,7 @@ const AddonBuildOptionsConfig = struct {
     napi_tsgen: bool = false,
     node_addon: bool = false,
     node_api: NodeApiOptions = .{},
+    async_runtime: AsyncRuntimeOptions = .{},
 };
 
 fn createAddonBuildOptions(build: *std.Build, config: AddonBuildOptionsConfig) *std.Build.Step.Options {
@@ -318,6 +336,10 @@ fn createAddonBuildOptions(build: *std.Build, config: AddonBuildOptionsConfig) *
     options.addOption(bool, "node_addon", config.node_addon);
     options.addOption(i32, "napi_version", config.node_api.effectiveVersion());
     options.addOption(bool, "napi_experimental", config.node_api.experimental);
+    options.addOption(u32, "async_workers", config.async_runtime.workers);
+    options.addOption(u64, "async_stack_size", config.async_runtime.stack_size);
+    options.addOption(u64, "async_affinity_mask", config.async_runtime.affinity_mask);
+    options.addOption(bool, "async_warm_start", config.async_runtime.warm_start);
     return options;
 }
 
@@ -363,6 +385,7 @@ fn arkvmHostAddonBuild(build: *std.Build, option: NativeAddonBuildOptionsWithMod
     compile.root_module.link_libc = true;
     const addon_build_options = createAddonBuildOptions(build, .{
         .node_api = option.node_api,
+        .async_runtime = option.async_runtime,
     });
     const build_options_module = addon_build_options.createModule();
     addConfiguredNapiImport(build, compile.root_module, option.napi_module, build_options_module, false);
@@ -383,6 +406,7 @@ pub fn nodeAddonBuild(build: *std.Build, option: NodeAddonBuildOptionsWithModule
     const addon_build_options = createAddonBuildOptions(build, .{
         .node_addon = true,
         .node_api = option.node_api,
+        .async_runtime = option.async_runtime,
     });
     const target = option.root_module_options.target orelse build.graph.host;
     const is_wasi = isWasiNodeAddonTarget(target.result);
@@ -547,6 +571,7 @@ pub fn nativeAddonBuild(build: *std.Build, option: NativeAddonBuildOptionsWithMo
 
     const addon_build_options = createAddonBuildOptions(build, .{
         .node_api = option.node_api,
+        .async_runtime = option.async_runtime,
     });
     const build_options_module = addon_build_options.createModule();
 
@@ -81,6 +81,11 @@ fn isAsyncDescriptorType(comptime T: type) bool {
     return @hasDecl(T, "is_napi_async_descriptor");
 }
 
+fn isAsyncStreamType(comptime T: type) bool {
+    if (!isAsyncDescriptorType(T)) return false;
+    return @hasDecl(T, "is_napi_async_stream");
+}
+
 fn isAbortSignalType(comptime T: type) bool {
     switch (@typeInfo(T)) {
         .@"struct", .@"enum", .@"union", .@"opaque" => {},
@@ -172,6 +177,11 @@ fn isThreadsafeFunctionType(comptime T: type) bool {
     return false;
 }
 
+fn isBatchedThreadsafeFunctionType(comptime T: type) bool {
+    if (@typeInfo(T) != .@"struct") return false;
+    return @hasDecl(T, "is_napi_batched_tsfn");
+}
+
 fn isReferenceType(comptime T: type) bool {
     switch (@typeInfo(T)) {
         .@"struct", .@"enum", .@"union", .@"opaque" => {},
@@ -188,6 +198,24 @@ fn isExternalType(comptime T: type) bool {
     return @hasDecl(T, "is_napi_external");
 }
 
+fn isSmallStringType(comptime T: type) bool {
+    switch (@typeInfo(T)) {
+        .@"struct", .@"enum", .@"union", .@"opaque" => {},
+        else => return false,
+    }
+    return @hasDecl(T, "is_napi_small_string");
+}
+
+fn isBorrowedType(comptime T: type) bool {
+    switch (@typeInfo(T)) {
+        .@"struct", .@"enum", .@"union", .@"opaque" => {},
+        else => return false,
+    }
+    return @hasDecl(T, "is_napi_borrowed");
+}
+
+const borrowed_bytes_ts_type = "Buffer | ArrayBuffer | Uint8Array";
+
 fn isDataViewType(comptime T: type) bool {
     switch (@typeInfo(T)) {
         .@"struct", .@"enum", .@"union", .@"opaque" => {},
@@ -245,6 +273,8 @@ fn isObjectLikeStruct(comptime T: type) bool {
     if (isDataViewType(T)) return false;
     if (isReferenceType(T)) return false;
     if (isExternalType(T)) return false;
+    if (isBorrowedType(T)) return false;
+    if (isSmallStringType(T)) return false;
     if (isClassType(T)) return false;
     if (isDtsType(T)) return false;
     return true;
@@ -256,6 +286,9 @@ const State = struct {
     exports: StringBuilder,
     emitted: std.StringHashMap(void),
     exported: std.StringHashMap(void),
+    /// Export name of each class wrapper, keyed by its Zig type name, so
+    /// values of the class type resolve to the declared JS class.
+    class_names: std.StringHashMap([]const u8),
     source: *SourceResolver,
 
     fn init(allocator: std.mem.Allocator, source: *SourceResolver) State {
@@ -265,6 +298,7 @@ const State = struct {
             .exports = StringBuilder.init(allocator),
             .emitted = std.StringHashMap(void).init(allocator),
             .exported = std.StringHashMap(void).init(allocator),
+            .class_names = std.StringHashMap([]const u8).init(allocator),
             .source = source,
         };
     }
@@ -274,6 +308,7 @@ const State = struct {
         self.exports.deinit();
         self.emitted.deinit();
         self.exported.deinit();
+        self.class_names.deinit();
     }
 };
 
@@ -1046,11 +1081,16 @@ fn emitType(state: *State, comptime T: type) ![]const u8 {
 
     if (isNumeric(T)) return "number";
     if (isStringLike(T)) return "string";
+    if (comptime isSmallStringType(T)) return "string";
     if (comptime isAbortSignalType(T)) {
         try emitAbortSignalDecl(state);
         return "AbortSignal";
     }
     if (isPromiseType(T)) return "Promise<void>";
+    if (comptime isAsyncStreamType(T)) {
+        const event_type = try emitType(state, asyncEventType(T));
+        return try std.fmt.allocPrint(state.allocator, "Promise<AsyncIterable<{s}>>", .{event_type});
+    }
     if (comptime isAsyncDescriptorType(T)) {
         const result_type = try emitType(state, asyncResultType(T));
         return try std.fmt.allocPrint(state.allocator, "Promise<{s}>", .{result_type});
@@ -1059,6 +1099,7 @@ fn emitType(state: *State, comptime T: type) ![]const u8 {
     if (T == napi.Buffer) return "Buffer";
     if (T == napi.ArrayBuffer) return "ArrayBuffer";
     if (T == napi.DataView) return "DataView";
+    if (comptime isBorrowedType(T)) return borrowed_bytes_ts_type;
 
     if (typedArrayName(T)) |name| return name;
 
@@ -1075,6 +1116,9 @@ fn emitType(state: *State, comptime T: type) ![]const u8 {
         },
         .pointer => {
             if (info.pointer.size == .one) {
+                if (comptime isBatchedThreadsafeFunctionType(info.pointer.child)) {
+                    return try emitBatchedCallbackType(state, info.pointer.child);
+                }
                 if (comptime isThreadsafeFunctionType(info.pointer.child)) {
                     return try emitFunctionLike(state, info.pointer.child, true);
                 }
@@ -1106,6 +1150,7 @@ fn emitType(state: *State, comptime T: type) ![]const u8 {
             }
 
             if (comptime isFunctionType(T)) return try emitFunctionLike(state, T, false);
+            if (comptime isBatchedThreadsafeFunctionType(T)) return try emitBatchedCallbackType(state, T);
             if (comptime isThreadsafeFunctionType(T)) return try emitFunctionLike(state, T, true);
 
             if (comptime isReferenceType(T)) {
@@ -1119,7 +1164,7 @@ fn emitType(state: *State, comptime T: type) ![]const u8 {
             }
 
             if (comptime isClassType(T)) {
-                return shortTypeName(T);
+                return state.class_names.get(@typeName(T)) orelse shortTypeName(T.WrappedType);
             }
 
             if (comptime isObjectLikeStruct(T)) {
@@ -1277,6 +1322,10 @@ fn emitFunctionLikeWithNames(state: *State, comptime T: type, comptime is_tsfn:
     return try buf.toOwnedSlice();
 }
 
+fn emitBatchedCallbackType(state: *State, comptime T: type) ![]const u8 {
+    return try std.fmt.allocPrint(state.allocator, "(batch: {s}) => void", .{try emitType(state, T.Batch)});
+}
+
 fn emitAsyncEventCallbackType(state: *State, comptime T: type) ![]const u8 {
     return try std.fmt.allocPrint(state.allocator, "(event: {s}) => void", .{try emitType(state, asyncEventType(T))});
 }
@@ -1843,6 +1892,18 @@ fn emitSourceTypeExpr(state: *State, file_path: []const u8, type_expr: []const u
             const child_ts = try emitSourceTypeExpr(state, file_path, type_call.arg, depth + 1);
             return try std.fmt.allocPrint(state.allocator, "ExternalObject<{s}>", .{child_ts});
         }
+        if (std.mem.eql(u8, type_call.callee, "napi.SmallString") or
+            std.mem.endsWith(u8, type_call.callee, ".SmallString") or
+            std.mem.eql(u8, type_call.callee, "SmallString"))
+        {
+            return "string";
+        }
+        if (std.mem.eql(u8, type_call.callee, "napi.Borrowed") or
+            std.mem.endsWith(u8, type_call.callee, ".Borrowed") or
+            std.mem.eql(u8, type_call.callee, "Borrowed"))
+        {
+            return borrowed_bytes_ts_type;
+        }
     }
 
     if (matchSourceSliceChild(trimmed)) |child| {
@@ -2021,6 +2082,13 @@ fn generate(allocator: std.mem.Allocator, io: std.Io, root_source_path: []const
 
     const Root = if (@TypeOf(root) == type) root else @TypeOf(root);
     const root_info = @typeInfo(Root).@"struct";
+    inline for (root_info.decls) |decl| {
+        const value = @field(root, decl.name);
+        if (comptime @TypeOf(value) == type and isClassType(value)) {
+            try state.class_names.put(@typeName(value), decl.name);
+        }
+    }
+
     inline for (root_info.fields) |field| {
         const value = @field(root, field.name);
         if (comptime @typeInfo(field.type) == .@"fn") {
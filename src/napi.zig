@@ -7,6 +7,7 @@ const module = @import("./prelude/module.zig");
 const worker = @import("./napi/wrapper/worker.zig");
 const err = @import("./napi/wrapper/error.zig");
 const thread_safe_function = @import("./napi/wrapper/thread_safe_function.zig");
+const batched_thread_safe_function = @import("./napi/wrapper/batched_thread_safe_function.zig");
 const async = @import("./napi/async.zig");
 const abort_signal = @import("./napi/abort_signal.zig");
 const class = @import("./napi/wrapper/class.zig");
@@ -16,7 +17,9 @@ const typedarray = @import("./napi/wrapper/typedarray.zig");
 const dataview = @import("./napi/wrapper/dataview.zig");
 const reference = @import("./napi/wrapper/reference.zig");
 const external = @import("./napi/wrapper/external.zig");
+const borrowed = @import("./napi/wrapper/borrowed.zig");
 const native_wrap = @import("./napi/wrapper/native_wrap.zig");
+const handle_scope = @import("./napi/wrapper/handle_scope.zig");
 const global_allocator = @import("./napi/util/allocator.zig");
 const options = @import("./napi/options.zig");
 const dts_override = @import("./napi/dts.zig");
@@ -30,6 +33,7 @@ pub const NapiValue = value.NapiValue;
 pub const Object = value.Object;
 pub const Number = value.Number;
 pub const String = value.String;
+pub const SmallString = value.SmallString;
 pub const BigInt = value.BigInt;
 pub const Null = value.Null;
 pub const Undefined = value.Undefined;
@@ -50,12 +54,20 @@ pub const Worker = worker.Worker;
 pub const ThreadSafeFunction = thread_safe_function.ThreadSafeFunction;
 pub const ThreadSafeFunctionMode = thread_safe_function.ThreadSafeFunctionMode;
 pub const ThreadSafeFunctionReleaseMode = thread_safe_function.ThreadSafeFunctionReleaseMode;
+pub const ThreadSafeFunctionStats = thread_safe_function.ThreadSafeFunctionStats;
+pub const ThreadSafeFunctionBackpressure = thread_safe_function.ThreadSafeFunctionBackpressure;
+pub const BatchedThreadSafeFunction = batched_thread_safe_function.BatchedThreadSafeFunction;
+pub const BatchOptions = batched_thread_safe_function.BatchOptions;
 pub const AsyncRuntime = async.RuntimeModel;
 pub const CancelToken = async.CancelToken;
+pub const AsyncEventPolicy = async.EventPolicy;
 pub const AbortSignal = abort_signal.AbortSignal;
 pub const resolveRequestedRuntime = async.resolveRequestedRuntime;
+pub const AsyncRuntimeConfig = async.AsyncRuntimeConfig;
+pub const configureAsyncRuntime = async.configureAsyncRuntime;
 pub const Class = class.Class;
 pub const ClassWithoutInit = class.ClassWithoutInit;
+pub const SharedClass = class.SharedClass;
 pub const Buffer = buffer.Buffer;
 pub const ArrayBuffer = arraybuffer.ArrayBuffer;
 pub const TypedArray = typedarray.TypedArray;
@@ -74,7 +86,10 @@ pub const DataView = dataview.DataView;
 pub const Reference = reference.Reference;
 pub const Ref = reference.Reference;
 pub const External = external.External;
+pub const Borrowed = borrowed.Borrowed;
 pub const NativeWrap = native_wrap;
+pub const HandleScope = handle_scope.HandleScope;
+pub const EscapableHandleScope = handle_scope.EscapableHandleScope;
 pub fn FunctionRef(comptime Args: type, comptime Return: type) type {
     return reference.Reference(function.Function(Args, Return));
 }
@@ -106,6 +121,24 @@ pub fn Async(comptime AsyncResult: type, comptime runtime: async.RuntimeModel) t
 pub fn AsyncWithEvents(comptime AsyncResult: type, comptime Event: type, comptime runtime: async.RuntimeModel) type {
     return async.AsyncWithEvents(AsyncResult, Event, runtime);
 }
+pub fn AsyncWithEventPolicy(
+    comptime AsyncResult: type,
+    comptime Event: type,
+    comptime runtime: async.RuntimeModel,
+    comptime policy: async.EventPolicy,
+) type {
+    return async.AsyncWithEventPolicy(AsyncResult, Event, runtime, policy);
+}
+pub fn AsyncBatch(comptime AsyncResult: type, comptime runtime: async.RuntimeModel) type {
+    return async.AsyncBatch(AsyncResult, runtime);
+}
+pub fn AsyncStream(comptime Event: type, comptime runtime: async.RuntimeModel) type {
+    return async.AsyncStream(Event, runtime);
+}
+pub fn AsyncParallel(comptime Element: type, comptime ParallelResult: type) type {
+    return async.AsyncParallel(Element, ParallelResult);
+}
+pub const parallelFor = async.parallelFor;
 
 pub const NODE_API_MODULE = module.NODE_API_MODULE;
 pub const NODE_API_MODULE_WITH_INIT = module.NODE_API_MODULE_WITH_INIT;
@@ -12,13 +12,56 @@ const AbortSignalModule = @import("./abort_signal.zig");
 const AbortSignal = @import("./abort_signal.zig").AbortSignal;
 const AbortRegistration = @import("./abort_signal.zig").AbortRegistration;
 const options = @import("./options.zig");
+const typedarray = @import("./wrapper/typedarray.zig");
+const Buffer = @import("./wrapper/buffer.zig").Buffer;
+const DataView = @import("./wrapper/dataview.zig").DataView;
+const helper = @import("./util/helper.zig");
+const instance_data = @import("./util/instance_data.zig");
+const async_dispatcher = @import("./async_dispatcher.zig");
+const wake_timer = @import("./util/wake_timer.zig");
+
+/// Pool shared by the `.thread` operations of every env in the process.
+const ThreadedRuntime = struct {
+    threaded: std.Io.Threaded,
+    workers: std.Io.Group = .init,
+    /// Worker loops alive. Guarded by `threaded_runtime_mutex`.
+    running: usize = 0,
+};
+
+/// A threaded operation waiting for, or running on, a pool worker.
+const ThreadJob = struct {
+    next: ?*ThreadJob = null,
+    run: *const fn (*ThreadJob) void,
+};
+
+/// FIFO of jobs waiting for a worker. Guarded by `threaded_runtime_mutex`.
+const ThreadJobQueue = struct {
+    head: ?*ThreadJob = null,
+    tail: ?*ThreadJob = null,
+
+    fn push(self: *ThreadJobQueue, job: *ThreadJob) void {
+        job.next = null;
+        if (self.tail) |tail| tail.next = job else self.head = job;
+        self.tail = job;
+    }
+
+    fn pop(self: *ThreadJobQueue) ?*ThreadJob {
+        const job = self.head orelse return null;
+        self.head = job.next;
+        if (self.head == null) self.tail = null;
+        job.next = null;
+        return job;
+    }
+};
 
-var threaded_runtime_mutex: std.atomic.Mutex = .unlocked;
-var threaded_runtime_initialized = false;
+// Blocking lock; the futex behind it does not need the pool it guards.
+var threaded_runtime_mutex: std.Io.Mutex = .init;
+var threaded_runtime: ?*ThreadedRuntime = null;
+var threaded_runtime_config: AsyncRuntimeConfig = .fromBuildOptions();
+var threaded_runtime_queue: ThreadJobQueue = .{};
 var threaded_runtime_active_operations: usize = 0;
-var threaded_runtime_cleanup_registered = false;
+var threaded_runtime_env_count: usize = 0;
 var threaded_runtime_cleanup_requested = false;
-var threaded_runtime: std.Io.Threaded = undefined;
 
 const use_wasm_emnapi_async_work = builtin.cpu.arch == .wasm32 and builtin.os.tag == .wasi;
 
@@ -76,87 +119,277 @@ fn singleIo() std.Io {
     return std.Io.Threaded.global_single_threaded.io();
 }
 
-fn deinitThreadedRuntimeLocked() void {
-    if (!threaded_runtime_initialized) {
-        threaded_runtime_cleanup_requested = false;
-        return;
+/// Settings of the shared pool behind `.thread` operations. Defaults come
+/// from the `async_runtime` build options.
+pub const AsyncRuntimeConfig = struct {
+    /// Operations running at once; further ones wait in a FIFO queue until a
+    /// worker frees up. 0 means one pool thread per in-flight operation.
+    workers: u32 = 0,
+    /// Stack size of pool threads in bytes. 0 keeps the std default.
+    stack_size: usize = 0,
+    /// CPUs pool threads may run on, one bit per CPU. 0 leaves the affinity
+    /// alone. Applied on Linux and OpenHarmony only.
+    affinity_mask: u64 = 0,
+    /// Start the workers together with the pool instead of on first use.
+    warm_start: bool = false,
+
+    fn fromBuildOptions() AsyncRuntimeConfig {
+        const defaults = options.asyncRuntimeDefaults();
+        return .{
+            .workers = defaults.workers,
+            .stack_size = @intCast(defaults.stack_size),
+            .affinity_mask = defaults.affinity_mask,
+            .warm_start = defaults.warm_start,
+        };
     }
+};
 
-    threaded_runtime.deinit();
-    threaded_runtime_initialized = false;
-    threaded_runtime_cleanup_requested = false;
-    threaded_runtime = undefined;
-}
+/// Replaces the pool settings. Call it before the first `.thread` operation,
+/// for example from module init; once the pool is running this fails with
+/// `GenericFailure` and the running pool keeps its settings. With
+/// `warm_start` the pool and its workers start before this returns.
+pub fn configureAsyncRuntime(config: AsyncRuntimeConfig) !void {
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
 
-fn threadedRuntimeCleanupHook(_: ?*anyopaque) callconv(.c) void {
-    while (!threaded_runtime_mutex.tryLock()) {
-        std.Thread.yield() catch {};
+    if (threaded_runtime != null) {
+        return NapiError.Error.fromReason("configureAsyncRuntime must run before the first threaded async operation");
     }
-    defer threaded_runtime_mutex.unlock();
+    threaded_runtime_config = config;
+    if (config.warm_start) _ = startThreadedRuntimeLocked();
+}
 
-    threaded_runtime_cleanup_registered = false;
-    threaded_runtime_cleanup_requested = true;
-    if (threaded_runtime_active_operations == 0) {
-        deinitThreadedRuntimeLocked();
-    }
+/// Called once the module's exports are set up. With `warm_start`, starts
+/// the pool if it is not running and counts `env` as one of its users, so
+/// the pool is shut down with the last env as usual. Best effort: a pool
+/// that cannot be warmed here still starts on first use.
+pub fn warmStartThreadedRuntime(env_raw: napi.napi_env) void {
+    lockThreadedRuntime();
+    const warm_start = threaded_runtime_config.warm_start;
+    unlockThreadedRuntime();
+    if (!warm_start) return;
+
+    registerThreadedRuntimeUser(env_raw) catch return;
+
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
+
+    if (threaded_runtime == null) _ = startThreadedRuntimeLocked();
+}
+
+fn lockThreadedRuntime() void {
+    threaded_runtime_mutex.lockUncancelable(singleIo());
 }
 
-fn ensureThreadedRuntimeCleanupHookLocked(env_raw: napi.napi_env) !void {
-    if (threaded_runtime_cleanup_registered) return;
+fn unlockThreadedRuntime() void {
+    threaded_runtime_mutex.unlock(singleIo());
+}
 
-    const status = napi.napi_add_env_cleanup_hook(env_raw, threadedRuntimeCleanupHook, null);
-    if (status != napi.napi_ok) {
-        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+const ThreadedInitOptions = @typeInfo(@TypeOf(std.Io.Threaded.init)).@"fn".params[1].type.?;
+
+fn threadedInitOptions(config: AsyncRuntimeConfig) ThreadedInitOptions {
+    var init_options: ThreadedInitOptions = .{};
+    if (comptime @hasField(ThreadedInitOptions, "stack_size")) {
+        if (config.stack_size != 0) init_options.stack_size = config.stack_size;
     }
-    threaded_runtime_cleanup_registered = true;
+    return init_options;
 }
 
-fn acquireThreadedRuntime(env_raw: napi.napi_env) !std.Io {
-    while (!threaded_runtime_mutex.tryLock()) {
-        std.Thread.yield() catch {};
+fn startThreadedRuntimeLocked() *ThreadedRuntime {
+    const runtime = GlobalAllocator.globalAllocator().create(ThreadedRuntime) catch @panic("OOM");
+    runtime.* = .{
+        .threaded = std.Io.Threaded.init(GlobalAllocator.globalAllocator(), threadedInitOptions(threaded_runtime_config)),
+    };
+    threaded_runtime = runtime;
+    if (threaded_runtime_config.warm_start) {
+        warmThreadedRuntime(runtime, workerLimit());
     }
-    defer threaded_runtime_mutex.unlock();
+    return runtime;
+}
 
-    if (threaded_runtime_cleanup_requested) {
-        return NapiError.Error.fromStatus(NapiError.Status.Closing);
+/// Unhooks the pool so a later operation starts a fresh one. The caller
+/// passes the result to `retireThreadedRuntime` after unlocking, because
+/// exiting workers take the lock on their way out.
+fn detachThreadedRuntimeLocked() ?*ThreadedRuntime {
+    threaded_runtime_cleanup_requested = false;
+    const runtime = threaded_runtime orelse return null;
+    threaded_runtime = null;
+    return runtime;
+}
+
+fn retireThreadedRuntime(runtime: ?*ThreadedRuntime) void {
+    const retired = runtime orelse return;
+    retired.workers.cancel(retired.threaded.io());
+    retired.threaded.deinit();
+    GlobalAllocator.globalAllocator().destroy(retired);
+}
+
+/// Registered in the instance data of every env that has used the threaded
+/// runtime. The shared pool is shut down once the last of those envs is torn
+/// down, so a worker exiting does not close the pool under other envs.
+const ThreadedRuntimeUser = struct {
+    env: napi.napi_env,
+
+    pub fn deinit(_: *ThreadedRuntimeUser, _: napi.napi_env) void {
+        var retired: ?*ThreadedRuntime = null;
+        defer retireThreadedRuntime(retired);
+
+        lockThreadedRuntime();
+        defer unlockThreadedRuntime();
+
+        std.debug.assert(threaded_runtime_env_count > 0);
+        threaded_runtime_env_count -= 1;
+        if (threaded_runtime_env_count > 0) return;
+
+        threaded_runtime_cleanup_requested = true;
+        if (threaded_runtime_active_operations == 0) {
+            retired = detachThreadedRuntimeLocked();
+        }
     }
+};
 
-    try ensureThreadedRuntimeCleanupHookLocked(env_raw);
+const ThreadedRuntimeUserSlot = instance_data.Slot(ThreadedRuntimeUser, ThreadedRuntimeUser);
 
-    if (!threaded_runtime_initialized) {
-        threaded_runtime = std.Io.Threaded.init(GlobalAllocator.globalAllocator(), .{});
-        threaded_runtime_initialized = true;
+fn registerThreadedRuntimeUser(env_raw: napi.napi_env) !void {
+    if (ThreadedRuntimeUserSlot.get(env_raw) != null) return;
+    _ = try ThreadedRuntimeUserSlot.put(env_raw, .{ .env = env_raw });
+
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
+
+    threaded_runtime_env_count += 1;
+    threaded_runtime_cleanup_requested = false;
+}
+
+fn acquireThreadedRuntime(env_raw: napi.napi_env) !void {
+    try registerThreadedRuntimeUser(env_raw);
+
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
+
+    if (threaded_runtime_cleanup_requested) {
+        return NapiError.Error.fromStatus(NapiError.Status.Closing);
     }
 
+    if (threaded_runtime == null) _ = startThreadedRuntimeLocked();
     threaded_runtime_active_operations += 1;
-    return threaded_runtime.io();
 }
 
 fn activeThreadedIo() std.Io {
-    while (!threaded_runtime_mutex.tryLock()) {
-        std.Thread.yield() catch {};
-    }
-    defer threaded_runtime_mutex.unlock();
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
 
-    std.debug.assert(threaded_runtime_initialized);
     std.debug.assert(threaded_runtime_active_operations > 0);
-    return threaded_runtime.io();
+    return threaded_runtime.?.threaded.io();
 }
 
 fn releaseThreadedRuntime() void {
-    while (!threaded_runtime_mutex.tryLock()) {
-        std.Thread.yield() catch {};
-    }
-    defer threaded_runtime_mutex.unlock();
+    var retired: ?*ThreadedRuntime = null;
+    defer retireThreadedRuntime(retired);
+
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
 
-    if (!threaded_runtime_initialized or threaded_runtime_active_operations == 0) {
+    if (threaded_runtime == null or threaded_runtime_active_operations == 0) {
         return;
     }
 
     threaded_runtime_active_operations -= 1;
     if (threaded_runtime_active_operations == 0 and threaded_runtime_cleanup_requested) {
-        deinitThreadedRuntimeLocked();
+        retired = detachThreadedRuntimeLocked();
+    }
+}
+
+fn workerLimit() usize {
+    return if (threaded_runtime_config.workers == 0) std.math.maxInt(usize) else threaded_runtime_config.workers;
+}
+
+/// Runs `job` on a pool worker, or queues it when every worker is busy.
+/// Safe from any JS thread.
+fn submitThreadJob(job: *ThreadJob) !void {
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
+
+    const runtime = threaded_runtime.?;
+    if (runtime.running >= workerLimit()) {
+        threaded_runtime_queue.push(job);
+        return;
+    }
+    try runtime.workers.concurrent(runtime.threaded.io(), workerLoop, .{ runtime, job });
+    runtime.running += 1;
+}
+
+/// A worker keeps taking queued jobs until the queue is empty, so capped
+/// pools hand work over without a round trip through the JS thread.
+fn workerLoop(runtime: *ThreadedRuntime, first: *ThreadJob) void {
+    applyWorkerAffinity();
+    var job = first;
+    while (true) {
+        job.run(job);
+        job = nextThreadJob(runtime) orelse return;
+    }
+}
+
+fn nextThreadJob(runtime: *ThreadedRuntime) ?*ThreadJob {
+    lockThreadedRuntime();
+    defer unlockThreadedRuntime();
+
+    // Workers of a retired pool do not pick up jobs of its successor.
+    if (threaded_runtime == runtime) {
+        if (threaded_runtime_queue.pop()) |job| return job;
+    }
+    runtime.running -= 1;
+    return null;
+}
+
+threadlocal var worker_affinity_applied = false;
+
+fn applyWorkerAffinity() void {
+    if (comptime builtin.os.tag != .linux) return;
+    if (worker_affinity_applied) return;
+    worker_affinity_applied = true;
+
+    const mask = threaded_runtime_config.affinity_mask;
+    if (mask == 0) return;
+
+    const linux = std.os.linux;
+    var set = std.mem.zeroes(linux.cpu_set_t);
+    const word_bits = @bitSizeOf(usize);
+    for (0..64) |cpu| {
+        if ((mask >> @intCast(cpu)) & 1 == 0) continue;
+        set[cpu / word_bits] |= @as(usize, 1) << @intCast(cpu % word_bits);
+    }
+    // Best effort: a mask outside the allowed CPUs leaves the thread as is.
+    _ = linux.syscall3(.sched_setaffinity, 0, @sizeOf(linux.cpu_set_t), @intFromPtr(&set));
+}
+
+/// Parks one task per worker until all of them run, so each lands on its own
+/// thread and the pool keeps those threads for the first operations.
+const WarmUp = struct {
+    started: std.atomic.Value(usize) = .init(0),
+    target: std.atomic.Value(usize) = .init(std.math.maxInt(usize)),
+
+    fn park(self: *WarmUp) void {
+        applyWorkerAffinity();
+        _ = self.started.fetchAdd(1, .acq_rel);
+        while (self.started.load(.acquire) < self.target.load(.acquire)) {
+            std.Thread.yield() catch {};
+        }
+    }
+};
+
+fn warmThreadedRuntime(runtime: *ThreadedRuntime, limit: usize) void {
+    const io = runtime.threaded.io();
+    const count = if (limit == std.math.maxInt(usize)) std.Thread.getCpuCount() catch 1 else limit;
+
+    var warm: WarmUp = .{};
+    var group: std.Io.Group = .init;
+    var spawned: usize = 0;
+    while (spawned < count) : (spawned += 1) {
+        group.concurrent(io, WarmUp.park, .{&warm}) catch break;
     }
+    warm.target.store(spawned, .release);
+    group.await(io) catch {};
 }
 
 fn ioForRuntime(effective_runtime: EffectiveRuntime) std.Io {
@@ -166,6 +399,171 @@ fn ioForRuntime(effective_runtime: EffectiveRuntime) std.Io {
     };
 }
 
+/// How `AsyncWithEventPolicy` hands events to the listener. Policies other
+/// than `.every` keep events in storage embedded in the operation, so an
+/// emit costs a short lock and, at most once per wake-up, a dispatcher post.
+pub const EventPolicy = union(enum) {
+    /// One listener call per event. Allocates per event on `.thread`.
+    every,
+    /// Only the newest event since the listener last ran.
+    latest,
+    /// Events since the listener last ran, passed as one array of up to
+    /// `n`. When more arrive first, the oldest are dropped.
+    coalesce: usize,
+    /// The newest event, with at most this many wake-ups per second. A
+    /// value held back by the rate limit is delivered once the period
+    /// expires, and the last one before the promise settles.
+    sampled: u32,
+};
+
+/// What an emit asks of the operation after storing an event.
+const EventWake = union(enum) {
+    none,
+    now,
+    /// Held back by the rate limit: wake once this many ns have passed.
+    after: u64,
+};
+
+fn EventDelivery(comptime Event: type, comptime policy: EventPolicy) type {
+    return switch (policy) {
+        .every => struct {
+            pub const Delivered = Event;
+            pub const Taken = void;
+
+            fn store(_: *@This(), _: Event) EventWake {
+                return .none;
+            }
+
+            fn woken(_: *@This()) void {}
+
+            fn take(_: *@This(), _: *Taken) ?Delivered {
+                return null;
+            }
+        },
+        .latest => LatestEventSlot(Event, 0),
+        .sampled => |hz| blk: {
+            if (hz == 0) @compileError("EventPolicy.sampled needs a rate above 0 Hz");
+            break :blk LatestEventSlot(Event, std.time.ns_per_s / hz);
+        },
+        .coalesce => |capacity| CoalescedEvents(Event, capacity),
+    };
+}
+
+/// Single-value slot. `store` reports whether the caller should post a
+/// wake-up: once per delivery, and no more often than `period_ns`. A value
+/// stored inside the period asks for a wake-up when the period ends.
+fn LatestEventSlot(comptime Event: type, comptime period_ns: u64) type {
+    return struct {
+        mutex: std.Io.Mutex = .init,
+        value: Event = undefined,
+        has_value: bool = false,
+        wake_posted: std.atomic.Value(bool) = .init(false),
+        last_wake_ns: std.atomic.Value(u64) = .init(0),
+
+        const Self = @This();
+        pub const Delivered = Event;
+        pub const Taken = void;
+
+        fn store(self: *Self, event: Event) EventWake {
+            const io = singleIo();
+            self.mutex.lockUncancelable(io);
+            self.value = event;
+            self.has_value = true;
+            self.mutex.unlock(io);
+
+            if (self.wake_posted.load(.acquire)) return .none;
+            if (period_ns != 0) {
+                const now = nowNs();
+                const last = self.last_wake_ns.load(.monotonic);
+                if (last != 0 and now -% last < period_ns) return .{ .after = period_ns - (now -% last) };
+                if (self.last_wake_ns.cmpxchgStrong(last, now, .monotonic, .monotonic) != null) return .none;
+            }
+            return if (self.wake_posted.swap(true, .acq_rel)) .none else .now;
+        }
+
+        /// Timer side of a held-back value: claims the wake-up unless one is
+        /// already posted.
+        fn expire(self: *Self) bool {
+            if (self.wake_posted.swap(true, .acq_rel)) return false;
+            self.last_wake_ns.store(nowNs(), .monotonic);
+            return true;
+        }
+
+        /// Called by the JS thread before `take`, so a store racing with the
+        /// delivery posts a fresh wake-up.
+        fn woken(self: *Self) void {
+            self.wake_posted.store(false, .release);
+        }
+
+        fn take(self: *Self, _: *Taken) ?Delivered {
+            const io = singleIo();
+            self.mutex.lockUncancelable(io);
+            defer self.mutex.unlock(io);
+            if (!self.has_value) return null;
+            self.has_value = false;
+            return self.value;
+        }
+    };
+}
+
+/// Ring of the newest `capacity` events, drained as one slice.
+fn CoalescedEvents(comptime Event: type, comptime capacity: usize) type {
+    if (capacity == 0) {
+        @compileError("EventPolicy.coalesce needs a capacity above 0");
+    }
+
+    return struct {
+        mutex: std.Io.Mutex = .init,
+        events: [capacity]Event = undefined,
+        head: usize = 0,
+        len: usize = 0,
+        wake_posted: std.atomic.Value(bool) = .init(false),
+
+        const Self = @This();
+        pub const Delivered = []const Event;
+        pub const Taken = [capacity]Event;
+
+        fn store(self: *Self, event: Event) EventWake {
+            const io = singleIo();
+            self.mutex.lockUncancelable(io);
+            if (self.len == capacity) {
+                self.head = (self.head + 1) % capacity;
+                self.len -= 1;
+            }
+            self.events[(self.head + self.len) % capacity] = event;
+            self.len += 1;
+            self.mutex.unlock(io);
+
+            return if (self.wake_posted.swap(true, .acq_rel)) .none else .now;
+        }
+
+        fn woken(self: *Self) void {
+            self.wake_posted.store(false, .release);
+        }
+
+        fn take(self: *Self, out: *Taken) ?Delivered {
+            const io = singleIo();
+            self.mutex.lockUncancelable(io);
+            defer self.mutex.unlock(io);
+            if (self.len == 0) return null;
+
+            const count = self.len;
+            for (0..count) |i| {
+                out[i] = self.events[(self.head + i) % capacity];
+            }
+            self.head = 0;
+            self.len = 0;
+            return out[0..count];
+        }
+    };
+}
+
+fn nowNs() u64 {
+    const reading = std.Io.Clock.awake.now(singleIo());
+    const timestamp = if (comptime @typeInfo(@TypeOf(reading)) == .error_union) reading catch return 0 else reading;
+    return @intCast(@max(timestamp.nanoseconds, 0));
+}
+
 pub fn AsyncContext(comptime Event: type) type {
     return struct {
         allocator: std.mem.Allocator,
@@ -283,21 +681,39 @@ fn validateTaskRunSignature(comptime Input: type, comptime Result: type, comptim
 
 pub fn Async(comptime Result: type, comptime runtime: RuntimeModel) type {
     comptime options.requireNapiVersion(.v4);
-    return AsyncTaskDescriptor(Result, void, runtime);
+    return AsyncTaskDescriptor(Result, void, runtime, .every);
 }
 
 pub fn AsyncWithEvents(comptime Result: type, comptime Event: type, comptime runtime: RuntimeModel) type {
     comptime options.requireNapiVersion(.v4);
-    return AsyncTaskDescriptor(Result, Event, runtime);
+    return AsyncTaskDescriptor(Result, Event, runtime, .every);
+}
+
+/// `AsyncWithEvents` with a delivery policy for its events. See
+/// `EventPolicy`.
+pub fn AsyncWithEventPolicy(
+    comptime Result: type,
+    comptime Event: type,
+    comptime runtime: RuntimeModel,
+    comptime policy: EventPolicy,
+) type {
+    comptime options.requireNapiVersion(.v4);
+    if (Event == void) {
+        @compileError("AsyncWithEventPolicy needs a non-void Event");
+    }
+    return AsyncTaskDescriptor(Result, Event, runtime, policy);
 }
 
-fn AsyncTaskDescriptor(comptime Result: type, comptime Event: type, comptime runtime: RuntimeModel) type {
+fn AsyncTaskDescriptor(comptime Result: type, comptime Event: type, comptime runtime: RuntimeModel, comptime policy: EventPolicy) type {
     comptime options.requireNapiVersion(.v4);
 
     return struct {
         pub const is_napi_async_descriptor = true;
         pub const async_result_type = Result;
-        pub const async_event_type = Event;
+        /// What the listener receives: one event, or an array of them for
+        /// `.coalesce`.
+        pub const async_event_type = EventDelivery(Event, policy).Delivered;
+        pub const async_event_policy = policy;
         pub const async_runtime_model = runtime;
         pub const async_has_events = Event != void;
 
@@ -310,7 +726,7 @@ fn AsyncTaskDescriptor(comptime Result: type, comptime Event: type, comptime run
             validateTaskRunSignature(Input, Result, Event, run_fn);
 
             const allocator = GlobalAllocator.globalAllocator();
-            const Impl = AsyncTaskDescriptorImpl(Input, Result, Event, runtime, run_fn);
+            const Impl = AsyncTaskDescriptorImpl(Input, Result, Event, runtime, policy, run_fn);
             var impl = allocator.create(Impl) catch @panic("OOM");
             impl.* = .{
                 .base = .{
@@ -357,6 +773,7 @@ fn AsyncTaskDescriptorImpl(
     comptime Result: type,
     comptime Event: type,
     comptime runtime: RuntimeModel,
+    comptime policy: EventPolicy,
     comptime run_fn: anytype,
 ) type {
     return struct {
@@ -369,7 +786,7 @@ fn AsyncTaskDescriptorImpl(
         fn schedule(base: *AsyncTaskDescriptorBase, env_raw: napi.napi_env, listener: ?napi.napi_value, signal: ?AbortSignal) !Promise {
             const self: *Self = @alignCast(@fieldParentPtr("base", base));
             errdefer base.destroy_fn(base);
-            const operation = try AsyncTaskOperation(Input, Result, Event, runtime, run_fn).create(Env.from_raw(env_raw), self.input, listener, signal);
+            const operation = try AsyncTaskOperation(Input, Result, Event, runtime, policy, run_fn).create(Env.from_raw(env_raw), self.input, listener, signal);
             self.input_moved = true;
             const promise = try operation.submit();
             base.destroy_fn(base);
@@ -391,6 +808,7 @@ fn AsyncTaskOperation(
     comptime Result: type,
     comptime Event: type,
     comptime runtime: RuntimeModel,
+    comptime policy: EventPolicy,
     comptime run_fn: anytype,
 ) type {
     return struct {
@@ -403,13 +821,14 @@ fn AsyncTaskOperation(
         listener_ref: ?napi.napi_ref = null,
         abort_registration: ?*AbortRegistration = null,
         cancel_token: CancelToken = .{},
-        future: ?std.Io.Future(void) = null,
-        controller_future: ?std.Io.Future(void) = null,
+        thread_job: ThreadJob = .{ .run = runThreadJob },
         async_work: napi.napi_async_work = null,
-        tsfn_raw: napi.napi_threadsafe_function = null,
-        state_mutex: std.Io.Mutex = .init,
-        state_cond: std.Io.Condition = .init,
-        task_done: bool = false,
+        dispatcher: ?*async_dispatcher.Dispatcher = null,
+        completion_node: async_dispatcher.Node = .{ .run = runCompletionNode },
+        events: Delivery = .{},
+        event_node: async_dispatcher.Node = .{ .run = runPolicyEventNode },
+        trailing_timer: if (trailing_wake) wake_timer.Entry else void = if (trailing_wake) .{ .fire = trailingExpired } else {},
+        task_done: std.atomic.Value(bool) = .init(false),
         cancel_requested: bool = false,
         cancel_dispatched: bool = false,
         closed: bool = false,
@@ -418,11 +837,15 @@ fn AsyncTaskOperation(
 
         const Self = @This();
         const Context = AsyncContext(Event);
+        const Delivery = EventDelivery(Event, policy);
+        /// Held-back sampled values get a timer wake-up on `.thread`. On
+        /// `.single` the completion flush already delivers them.
+        const trailing_wake = policy == .sampled and !use_wasm_emnapi_async_work;
         const run_info = @typeInfo(@TypeOf(run_fn)).@"fn";
-        const DispatchKind = enum { event, completion };
-        const DispatchData = struct {
-            kind: DispatchKind,
-            payload: ?*Event = null,
+        const EventNode = struct {
+            node: async_dispatcher.Node = .{ .run = runEventNode },
+            operation: *Self,
+            event: Event,
         };
 
         fn create(env: Env, input: Input, listener: ?napi.napi_value, signal: ?AbortSignal) !*Self {
@@ -466,19 +889,10 @@ fn AsyncTaskOperation(
                         return promise;
                     }
 
-                    const io = try acquireThreadedRuntime(self.env);
+                    try acquireThreadedRuntime(self.env);
                     self.uses_threaded_runtime = true;
-                    try self.initThreadDispatcher();
-                    self.future = std.Io.concurrent(io, runTask, .{self}) catch |err| {
-                        self.err = mapAnyError(err);
-                        self.dispatchCompletion(self.env);
-                        return promise;
-                    };
-                    self.controller_future = std.Io.concurrent(io, controllerTask, .{self}) catch |err| {
-                        if (self.future) |*future| {
-                            future.cancel(io);
-                            self.future = null;
-                        }
+                    try self.attachDispatcher();
+                    submitThreadJob(&self.thread_job) catch |err| {
                         self.err = mapAnyError(err);
                         self.dispatchCompletion(self.env);
                         return promise;
@@ -488,17 +902,19 @@ fn AsyncTaskOperation(
             return promise;
         }
 
-        fn controllerTask(self: *Self) void {
-            const io = self.operationIo();
-            const should_cancel = self.waitForTaskDoneOrAbort();
-            if (self.future) |*future| {
-                if (should_cancel) {
-                    future.cancel(io);
-                    self.cancel_dispatched = true;
-                } else {
-                    future.await(io);
-                }
+        /// Runs on a pool worker: it does the work and reports its own
+        /// completion, so no second task waits beside it. The worker must not
+        /// touch the operation once the completion is queued.
+        fn runThreadJob(job: *ThreadJob) void {
+            const self: *Self = @alignCast(@fieldParentPtr("thread_job", job));
+            // Aborted while waiting in the queue: skip the work.
+            if (self.cancel_token.isCancelled()) {
+                self.task_done.store(true, .release);
+            } else {
+                self.runTask();
             }
+            // No emit follows, and the timer must not post after completion.
+            if (comptime trailing_wake) wake_timer.cancel(&self.trailing_timer);
             self.queueCompletion() catch {};
         }
 
@@ -510,7 +926,7 @@ fn AsyncTaskOperation(
         }
 
         fn runTask(self: *Self) void {
-            defer self.markTaskDone();
+            defer self.task_done.store(true, .release);
 
             const task_runtime = effectiveRuntime(runtime);
             self.runTaskWithIo(ioForRuntime(task_runtime), switch (task_runtime) {
@@ -539,13 +955,16 @@ fn AsyncTaskOperation(
                 self.err = mapAnyError(err);
                 return;
             };
+            // After an abort, stop child tasks through the Io cancel API
+            // instead of waiting for them.
+            if (self.cancel_token.isCancelled()) return;
             group.await(io) catch |err| {
                 self.err = mapAnyError(err);
             };
         }
 
         fn runWasmAsyncWork(self: *Self) !void {
-            try self.initThreadDispatcher();
+            try self.attachDispatcher();
 
             const resource_name = String.New(Env.from_raw(self.env), "ZigAsyncTask");
             var async_work: napi.napi_async_work = null;
@@ -585,9 +1004,10 @@ fn AsyncTaskOperation(
                 _ = napi.napi_delete_async_work(inner_env, self.async_work);
                 self.async_work = null;
             }
-            self.queueCompletion() catch {
-                self.dispatchCompletion(inner_env);
-            };
+            // Already on the JS thread. Posting with a fallback could settle
+            // the operation while its completion node is still queued.
+            if (self.dispatcher) |dispatcher| dispatcher.runPending(inner_env);
+            self.dispatchCompletion(inner_env);
         }
 
         fn isAbortRequestedFromSignal(self: *Self) bool {
@@ -605,42 +1025,19 @@ fn AsyncTaskOperation(
             self.requestAbort();
         }
 
+        /// Runs on the JS thread from the abort signal. The task observes the
+        /// cancel token and reports completion itself; the promise is rejected
+        /// when that completion is dispatched. Nothing interrupts the run
+        /// function through its `Io`: abort lands at its next token check.
         fn requestAbort(self: *Self) void {
-            const io = self.operationIo();
             self.cancel_token.cancel();
-            self.state_mutex.lockUncancelable(io);
-            defer self.state_mutex.unlock(io);
-            if (self.task_done) return;
+            if (self.task_done.load(.acquire)) return;
             self.cancel_requested = true;
             if (comptime use_wasm_emnapi_async_work) {
                 if (self.async_work != null) {
                     _ = napi.napi_cancel_async_work(self.env, self.async_work);
                 }
             }
-            self.state_cond.signal(io);
-        }
-
-        fn markTaskDone(self: *Self) void {
-            const io = self.operationIo();
-            self.state_mutex.lockUncancelable(io);
-            defer self.state_mutex.unlock(io);
-            self.task_done = true;
-            self.state_cond.signal(io);
-        }
-
-        fn waitForTaskDoneOrAbort(self: *Self) bool {
-            const io = self.operationIo();
-            self.state_mutex.lockUncancelable(io);
-            defer self.state_mutex.unlock(io);
-
-            while (!self.task_done and !self.cancel_requested) {
-                self.state_cond.waitUncancelable(io, &self.state_mutex);
-            }
-            return self.cancel_requested and !self.task_done;
-        }
-
-        fn operationIo(self: *const Self) std.Io {
-            return if (self.uses_threaded_runtime) activeThreadedIo() else singleIo();
         }
 
         fn execute(self: *Self, context: Context) !void {
@@ -684,32 +1081,68 @@ fn AsyncTaskOperation(
             try self.cancel_token.check();
 
             switch (effectiveRuntime(runtime)) {
-                .single => self.dispatchEvent(self.env, event),
+                .single => {
+                    if (comptime policy == .every) {
+                        self.dispatchEvent(self.env, event);
+                    } else if (self.events.store(event) == .now) {
+                        self.events.woken();
+                        self.flushPolicyEvents(self.env);
+                    }
+                },
                 .thread => {
-                    const payload = try self.allocator.create(Event);
-                    payload.* = event;
-                    errdefer self.allocator.destroy(payload);
-
-                    const data = try self.allocator.create(DispatchData);
-                    data.* = .{ .kind = .event, .payload = payload };
-                    errdefer self.allocator.destroy(data);
-
-                    const status = napi.napi_call_threadsafe_function(self.tsfn_raw, @ptrCast(data), napi.napi_tsfn_nonblocking);
-                    if (status != napi.napi_ok) {
-                        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+                    if (comptime policy == .every) {
+                        const event_node = try self.allocator.create(EventNode);
+                        event_node.* = .{ .operation = self, .event = event };
+                        try self.dispatcher.?.post(&event_node.node);
+                    } else switch (self.events.store(event)) {
+                        .none => {},
+                        .now => try self.dispatcher.?.post(&self.event_node),
+                        .after => |delay_ns| if (comptime trailing_wake) wake_timer.schedule(&self.trailing_timer, delay_ns),
                     }
                 },
             }
         }
 
+        fn trailingExpired(entry: *wake_timer.Entry) void {
+            const self: *Self = @fieldParentPtr("trailing_timer", entry);
+            if (!self.events.expire()) return;
+            self.dispatcher.?.post(&self.event_node) catch {};
+        }
+
+        fn runPolicyEventNode(node: *async_dispatcher.Node, env_raw: napi.napi_env) void {
+            const self: *Self = @alignCast(@fieldParentPtr("event_node", node));
+            self.events.woken();
+            self.flushPolicyEvents(env_raw);
+        }
+
+        /// Hands what the policy kept to the listener. JS thread only.
+        fn flushPolicyEvents(self: *Self, env_raw: napi.napi_env) void {
+            if (comptime policy == .every or Event == void) return;
+            var taken: Delivery.Taken = undefined;
+            const delivered = self.events.take(&taken) orelse return;
+            if (self.listener_ref == null) return;
+            const value = Napi.to_napi_value(env_raw, delivered, null) catch return;
+            self.callListener(env_raw, value);
+        }
+
+        fn runEventNode(node: *async_dispatcher.Node, env_raw: napi.napi_env) void {
+            const event_node: *EventNode = @alignCast(@fieldParentPtr("node", node));
+            const self = event_node.operation;
+            defer self.allocator.destroy(event_node);
+            self.dispatchEvent(env_raw, event_node.event);
+        }
+
         fn dispatchEvent(self: *Self, env_raw: napi.napi_env, event: Event) void {
             if (Event == void or self.listener_ref == null) return;
+            const event_value = Napi.to_napi_value(env_raw, event, null) catch return;
+            self.callListener(env_raw, event_value);
+        }
 
+        fn callListener(self: *Self, env_raw: napi.napi_env, event_value: napi.napi_value) void {
             var callback: napi.napi_value = undefined;
             const get_ref_status = napi.napi_get_reference_value(env_raw, self.listener_ref.?, &callback);
             if (get_ref_status != napi.napi_ok) return;
 
-            const event_value = Napi.to_napi_value(env_raw, event, null) catch return;
             const undefined_value = Undefined.New(Env.from_raw(env_raw));
             const argv = [1]napi.napi_value{event_value};
             var ignored: napi.napi_value = undefined;
@@ -717,25 +1150,18 @@ fn AsyncTaskOperation(
         }
 
         fn queueCompletion(self: *Self) !void {
-            const data = try self.allocator.create(DispatchData);
-            data.* = .{ .kind = .completion };
-            errdefer self.allocator.destroy(data);
+            try self.dispatcher.?.post(&self.completion_node);
+        }
 
-            const status = napi.napi_call_threadsafe_function(self.tsfn_raw, @ptrCast(data), napi.napi_tsfn_nonblocking);
-            if (status != napi.napi_ok) {
-                return NapiError.Error.fromStatus(NapiError.Status.New(status));
-            }
+        fn runCompletionNode(node: *async_dispatcher.Node, env_raw: napi.napi_env) void {
+            const self: *Self = @alignCast(@fieldParentPtr("completion_node", node));
+            self.dispatchCompletion(env_raw);
         }
 
         fn dispatchCompletion(self: *Self, env_raw: napi.napi_env) void {
-            if (self.controller_future) |*controller_future| {
-                controller_future.await(self.operationIo());
-                self.controller_future = null;
-                self.future = null;
-            } else if (self.future) |*future| {
-                future.await(self.operationIo());
-                self.future = null;
-            }
+            // A sampled value held back by the rate limit still arrives
+            // before the promise settles.
+            self.flushPolicyEvents(env_raw);
 
             const promise = self.promise;
             var settled_value: ?napi.napi_value = null;
@@ -764,67 +1190,10 @@ fn AsyncTaskOperation(
             }
         }
 
-        fn initThreadDispatcher(self: *Self) !void {
-            const resource_name = String.New(Env.from_raw(self.env), "ZigAsyncTask");
-            var dispatcher_fn: napi.napi_value = undefined;
-            const create_fn_status = napi.napi_create_function(
-                self.env,
-                "zigAsyncTask",
-                "zigAsyncTask".len,
-                dispatcherNoop,
-                null,
-                &dispatcher_fn,
-            );
-            if (create_fn_status != napi.napi_ok) {
-                return NapiError.Error.fromStatus(NapiError.Status.New(create_fn_status));
-            }
-
-            var tsfn_raw: napi.napi_threadsafe_function = null;
-            const create_status = napi.napi_create_threadsafe_function(
-                self.env,
-                dispatcher_fn,
-                null,
-                resource_name.raw,
-                0,
-                1,
-                null,
-                dispatcherFinalize,
-                @ptrCast(self),
-                dispatcherCallJs,
-                &tsfn_raw,
-            );
-            if (create_status != napi.napi_ok) {
-                return NapiError.Error.fromStatus(NapiError.Status.New(create_status));
-            }
-            self.tsfn_raw = tsfn_raw;
-        }
-
-        fn dispatcherNoop(inner_env: napi.napi_env, _: napi.napi_callback_info) callconv(.c) napi.napi_value {
-            return Undefined.New(Env.from_raw(inner_env)).raw;
-        }
-
-        fn dispatcherFinalize(_: napi.napi_env, _: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {}
-
-        fn dispatcherCallJs(inner_env: napi.napi_env, _: napi.napi_value, context: ?*anyopaque, raw_data: ?*anyopaque) callconv(.c) void {
-            const self: *Self = @ptrCast(@alignCast(context));
-            const data: *DispatchData = @ptrCast(@alignCast(raw_data));
-            const allocator = self.allocator;
-
-            switch (data.kind) {
-                .event => {
-                    defer allocator.destroy(data);
-                    if (Event != void and data.payload != null) {
-                        const payload = data.payload.?;
-                        defer allocator.destroy(payload);
-                        self.dispatchEvent(inner_env, payload.*);
-                    }
-                },
-                .completion => {
-                    allocator.destroy(data);
-                    self.dispatchCompletion(inner_env);
-                    return;
-                },
-            }
+        fn attachDispatcher(self: *Self) !void {
+            const dispatcher = try async_dispatcher.Dispatcher.get(self.env);
+            dispatcher.beginOperation();
+            self.dispatcher = dispatcher;
         }
 
         fn destroy(self: *Self, env_raw: napi.napi_env) void {
@@ -838,15 +1207,16 @@ fn AsyncTaskOperation(
                 registration.release();
                 self.abort_registration = null;
             }
-            if (self.tsfn_raw != null) {
-                _ = napi.napi_release_threadsafe_function(self.tsfn_raw, napi.napi_tsfn_release);
-                self.tsfn_raw = null;
+            if (self.dispatcher) |dispatcher| {
+                dispatcher.endOperation();
+                self.dispatcher = null;
             }
             if (self.async_work != null) {
                 _ = napi.napi_delete_async_work(env_raw, self.async_work);
                 self.async_work = null;
             }
             var deinit_state = Napi.DeinitState{};
+            defer deinit_state.deinit();
             Napi.deinit_napi_value_with_state(Input, self.input, &deinit_state);
             if (comptime Result != void) {
                 if (self.result_ready) {
@@ -861,17 +1231,1470 @@ fn AsyncTaskOperation(
     };
 }
 
-test "Async descriptor exposes runtime metadata" {
-    const Task = Async(u32, .thread);
-    try std.testing.expect(Task.is_napi_async_descriptor);
-    try std.testing.expect(Task.async_result_type == u32);
-    try std.testing.expect(Task.async_event_type == void);
-    try std.testing.expect(Task.async_runtime_model == .thread);
+/// Runs `run_fn` once per input on the async runtime and settles a single
+/// promise with all results in input order: a TypedArray for numeric
+/// results, an array otherwise.
+///
+/// Inputs are fanned out over at most `parallelism` pool workers. Each
+/// worker claims the next input with one atomic increment and writes into a
+/// results slice allocated up front. The first failure or an abort stops the
+/// remaining inputs and rejects the promise.
+pub fn AsyncBatch(comptime Result: type, comptime runtime: RuntimeModel) type {
+    comptime options.requireNapiVersion(.v4);
+    if (Result == void) {
+        @compileError("AsyncBatch needs a non-void Result");
+    }
+
+    return struct {
+        pub const is_napi_async_descriptor = true;
+        pub const async_result_type = Results;
+        pub const async_event_type = void;
+        pub const async_runtime_model = runtime;
+        pub const async_has_events = false;
+        pub const packed_results = typedarray.isSupportedElementType(Result);
+        /// The value the promise resolves with.
+        pub const Results = if (packed_results) typedarray.TypedArray(Result) else []const Result;
+
+        base: *AsyncTaskDescriptorBase,
+
+        const Self = @This();
+
+        /// Uses the pool's worker limit, or the CPU count, as parallelism.
+        pub fn from(inputs: anytype, comptime run_fn: anytype) Self {
+            return fromWithParallelism(inputs, 0, run_fn);
+        }
+
+        /// Runs at most `parallelism` inputs at once. 0 picks the default.
+        pub fn fromWithParallelism(inputs: anytype, parallelism: usize, comptime run_fn: anytype) Self {
+            const Inputs = @TypeOf(inputs);
+            const inputs_info = @typeInfo(Inputs);
+            if (inputs_info != .pointer or inputs_info.pointer.size != .slice) {
+                @compileError("AsyncBatch inputs must be a slice, got: " ++ @typeName(Inputs));
+            }
+            validateTaskRunSignature(inputs_info.pointer.child, Result, void, run_fn);
+
+            const allocator = GlobalAllocator.globalAllocator();
+            const Impl = AsyncBatchDescriptorImpl(Inputs, Result, runtime, run_fn);
+            var impl = allocator.create(Impl) catch @panic("OOM");
+            impl.* = .{
+                .base = .{
+                    .allocator = allocator,
+                    .schedule_fn = Impl.schedule,
+                    .destroy_fn = Impl.destroy,
+                },
+                .inputs = inputs,
+                .parallelism = parallelism,
+            };
+            return .{ .base = &impl.base };
+        }
+
+        pub fn schedule(self: *Self, env: Env) !Promise {
+            return try self.scheduleWithListenerAndSignal(env, null, null);
+        }
+
+        pub fn scheduleWithSignal(self: *Self, env: Env, signal: ?AbortSignal) !Promise {
+            return try self.scheduleWithListenerAndSignal(env, null, signal);
+        }
+
+        pub fn scheduleWithListenerAndSignal(self: *Self, env: Env, listener: ?napi.napi_value, signal: ?AbortSignal) !Promise {
+            const base = self.base;
+            return try base.schedule_fn(base, env.raw, listener, signal);
+        }
+
+        pub fn deinit(self: *Self) void {
+            self.base.destroy_fn(self.base);
+        }
+    };
 }
 
-test "AsyncWithEvents descriptor marks callback support" {
-    const Event = struct { current: u32 };
-    const Task = AsyncWithEvents(u32, Event, .single);
-    try std.testing.expect(Task.async_has_events);
+fn AsyncBatchDescriptorImpl(
+    comptime Inputs: type,
+    comptime Result: type,
+    comptime runtime: RuntimeModel,
+    comptime run_fn: anytype,
+) type {
+    return struct {
+        base: AsyncTaskDescriptorBase,
+        inputs: Inputs,
+        parallelism: usize,
+        inputs_moved: bool = false,
+
+        const Self = @This();
+
+        fn schedule(base: *AsyncTaskDescriptorBase, env_raw: napi.napi_env, _: ?napi.napi_value, signal: ?AbortSignal) !Promise {
+            const self: *Self = @alignCast(@fieldParentPtr("base", base));
+            errdefer base.destroy_fn(base);
+            const Operation = AsyncBatchOperation(Inputs, Result, runtime, run_fn, BatchOutput(Result, runtime));
+            const operation = try Operation.create(Env.from_raw(env_raw), self.inputs, self.parallelism, signal, .{});
+            self.inputs_moved = true;
+            const promise = try operation.submit();
+            base.destroy_fn(base);
+            return promise;
+        }
+
+        fn destroy(base: *AsyncTaskDescriptorBase) void {
+            const self: *Self = @alignCast(@fieldParentPtr("base", base));
+            if (!self.inputs_moved) {
+                Napi.deinit_napi_value(Inputs, self.inputs);
+            }
+            self.base.allocator.destroy(self);
+        }
+    };
+}
+
+fn defaultBatchParallelism() usize {
+    lockThreadedRuntime();
+    const workers = threaded_runtime_config.workers;
+    unlockThreadedRuntime();
+
+    if (workers != 0) return workers;
+    return std.Thread.getCpuCount() catch 1;
+}
+
+/// Settles an `AsyncBatch` with one value per input.
+fn BatchOutput(comptime Result: type, comptime runtime: RuntimeModel) type {
+    return struct {
+        const Batch = AsyncBatch(Result, runtime);
+
+        fn value(_: *@This(), env_raw: napi.napi_env, results: []Result) !napi.napi_value {
+            if (comptime Batch.packed_results) {
+                return (try Batch.Results.copy(Env.from_raw(env_raw), results)).raw;
+            }
+            return try Napi.to_napi_value(env_raw, @as([]const Result, results), null);
+        }
+
+        fn release(_: *@This(), _: napi.napi_env) void {}
+    };
+}
+
+/// `Output` turns the finished results into the resolved value with
+/// `value(env, results)` and drops whatever it holds with `release(env)`.
+fn AsyncBatchOperation(
+    comptime Inputs: type,
+    comptime Result: type,
+    comptime runtime: RuntimeModel,
+    comptime run_fn: anytype,
+    comptime Output: type,
+) type {
+    return struct {
+        allocator: std.mem.Allocator,
+        env: napi.napi_env,
+        promise: Promise,
+        inputs: Inputs,
+        parallelism: usize,
+        output: Output,
+        results: []Result,
+        /// Marks the slots of `results` that hold a value to free.
+        ready: []bool,
+        lanes: []Lane = &.{},
+        next_index: std.atomic.Value(usize) = .init(0),
+        lanes_left: std.atomic.Value(usize) = .init(0),
+        failed: std.atomic.Value(bool) = .init(false),
+        err: ?NapiError.Error = null,
+        abort_registration: ?*AbortRegistration = null,
+        cancel_token: CancelToken = .{},
+        async_work: napi.napi_async_work = null,
+        dispatcher: ?*async_dispatcher.Dispatcher = null,
+        completion_node: async_dispatcher.Node = .{ .run = runCompletionNode },
+        task_done: std.atomic.Value(bool) = .init(false),
+        cancel_requested: bool = false,
+        cancel_dispatched: bool = false,
+        closed: bool = false,
+        uses_threaded_runtime: bool = false,
+
+        const Self = @This();
+        const Context = AsyncContext(void);
+        const run_info = @typeInfo(@TypeOf(run_fn)).@"fn";
+        const returns_error = @typeInfo(run_info.return_type.?) == .error_union;
+
+        /// One pool job per unit of parallelism; every lane drains the
+        /// shared input index until it runs out.
+        const Lane = struct {
+            job: ThreadJob = .{ .run = runLane },
+            operation: *Self,
+        };
+
+        fn create(env: Env, inputs: Inputs, parallelism: usize, signal: ?AbortSignal, output: Output) !*Self {
+            const allocator = GlobalAllocator.globalAllocator();
+            const self = try allocator.create(Self);
+            errdefer allocator.destroy(self);
+
+            const results = try allocator.alloc(Result, inputs.len);
+            errdefer allocator.free(results);
+            const ready = try allocator.alloc(bool, inputs.len);
+            errdefer allocator.free(ready);
+            @memset(ready, false);
+
+            self.* = .{
+                .allocator = allocator,
+                .env = env.raw,
+                .promise = Promise.New(env),
+                .inputs = inputs,
+                .parallelism = parallelism,
+                .output = output,
+                .results = results,
+                .ready = ready,
+            };
+
+            if (signal) |abort_signal| {
+                self.abort_registration = try abort_signal.bind(@ptrCast(self), requestAbortFromSignal);
+            }
+
+            return self;
+        }
+
+        fn submit(self: *Self) !Promise {
+            errdefer self.destroy(self.env);
+
+            const promise = self.promise;
+            if (self.abort_registration != null and self.isAbortRequestedFromSignal()) {
+                self.cancel_token.cancel();
+                self.cancel_requested = true;
+                self.promise.RejectAbortError() catch {};
+                self.destroy(self.env);
+                return promise;
+            }
+
+            if (self.inputs.len == 0) {
+                self.task_done.store(true, .release);
+                self.dispatchCompletion(self.env);
+                return promise;
+            }
+
+            switch (effectiveRuntime(runtime)) {
+                .single => {
+                    self.runItems(singleIo(), .single);
+                    self.task_done.store(true, .release);
+                    self.dispatchCompletion(self.env);
+                },
+                .thread => {
+                    if (comptime use_wasm_emnapi_async_work) {
+                        try self.runWasmAsyncWork();
+                        return promise;
+                    }
+
+                    try acquireThreadedRuntime(self.env);
+                    self.uses_threaded_runtime = true;
+                    try self.attachDispatcher();
+
+                    const parallelism = if (self.parallelism == 0) defaultBatchParallelism() else self.parallelism;
+                    const lane_count = @min(self.inputs.len, parallelism);
+                    self.lanes = try self.allocator.alloc(Lane, lane_count);
+                    for (self.lanes) |*lane| lane.* = .{ .operation = self };
+
+                    self.lanes_left.store(lane_count, .release);
+                    for (self.lanes, 0..) |*lane, i| {
+                        submitThreadJob(&lane.job) catch |err| {
+                            // Lanes already running finish the inputs; the
+                            // ones never started are accounted for here.
+                            self.recordError(mapAnyError(err));
+                            self.finishLanes(lane_count - i);
+                            return promise;
+                        };
+                    }
+                },
+            }
+            return promise;
+        }
+
+        fn runLane(job: *ThreadJob) void {
+            const lane: *Lane = @alignCast(@fieldParentPtr("job", job));
+            const self = lane.operation;
+            self.runItems(activeThreadedIo(), .thread);
+            self.finishLanes(1);
+        }
+
+        /// The last lane out reports completion. Nothing may touch the
+        /// operation after that.
+        fn finishLanes(self: *Self, count: usize) void {
+            if (self.lanes_left.fetchSub(count, .acq_rel) != count) return;
+            self.task_done.store(true, .release);
+            self.queueCompletion() catch {};
+        }
+
+        fn runItems(self: *Self, io: std.Io, effective_runtime: RuntimeModel) void {
+            NapiError.clearLastError();
+            while (!self.failed.load(.acquire) and !self.cancel_token.isCancelled()) {
+                const index = self.next_index.fetchAdd(1, .monotonic);
+                if (index >= self.inputs.len) return;
+                self.runItem(io, effective_runtime, index) catch |err| {
+                    self.recordError(mapAnyError(err));
+                    return;
+                };
+            }
+        }
+
+        fn runItem(self: *Self, io: std.Io, effective_runtime: RuntimeModel, index: usize) !void {
+            if (run_info.params.len == 1) {
+                const ret = run_fn(self.inputs[index]);
+                self.results[index] = if (comptime returns_error) try ret else ret;
+                self.ready[index] = true;
+            } else {
+                var group: std.Io.Group = .init;
+                defer group.cancel(io);
+
+                const context = Context{
+                    .allocator = self.allocator,
+                    .io = io,
+                    .group = &group,
+                    .runtime = runtime,
+                    .effective_runtime = effective_runtime,
+                    .cancel_token = &self.cancel_token,
+                    .emitter_ptr = null,
+                    .emit_fn = null,
+                };
+                const ret = run_fn(context, self.inputs[index]);
+                self.results[index] = if (comptime returns_error) try ret else ret;
+                self.ready[index] = true;
+                if (self.cancel_token.isCancelled()) return;
+                try group.await(io);
+            }
+        }
+
+        /// Keeps the first error; later lanes stop at their next input.
+        fn recordError(self: *Self, err: NapiError.Error) void {
+            if (self.failed.swap(true, .acq_rel)) return;
+            self.err = err;
+        }
+
+        fn runWasmAsyncWork(self: *Self) !void {
+            try self.attachDispatcher();
+
+            const resource_name = String.New(Env.from_raw(self.env), "ZigAsyncBatch");
+            var async_work: napi.napi_async_work = null;
+            const create_status = napi.napi_create_async_work(
+                self.env,
+                null,
+                resource_name.raw,
+                wasmAsyncWorkExecute,
+                wasmAsyncWorkComplete,
+                @ptrCast(self),
+                &async_work,
+            );
+            if (create_status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(create_status));
+            }
+            self.async_work = async_work;
+
+            const queue_status = napi.napi_queue_async_work(self.env, async_work);
+            if (queue_status != napi.napi_ok) {
+                _ = napi.napi_delete_async_work(self.env, async_work);
+                self.async_work = null;
+                return NapiError.Error.fromStatus(NapiError.Status.New(queue_status));
+            }
+        }
+
+        fn wasmAsyncWorkExecute(_: napi.napi_env, data: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(data));
+            self.runItems(singleIo(), .thread);
+            self.task_done.store(true, .release);
+        }
+
+        fn wasmAsyncWorkComplete(inner_env: napi.napi_env, status: napi.napi_status, data: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(data));
+            if (status == napi.napi_cancelled) {
+                self.cancel_dispatched = true;
+            }
+            if (self.async_work != null) {
+                _ = napi.napi_delete_async_work(inner_env, self.async_work);
+                self.async_work = null;
+            }
+            // Already on the JS thread. Posting with a fallback could settle
+            // the operation while its completion node is still queued.
+            if (self.dispatcher) |dispatcher| dispatcher.runPending(inner_env);
+            self.dispatchCompletion(inner_env);
+        }
+
+        fn isAbortRequestedFromSignal(self: *Self) bool {
+            if (self.abort_registration) |registration| {
+                var signal_value: napi.napi_value = undefined;
+                const ref_status = napi.napi_get_reference_value(self.env, registration.signal_ref, &signal_value);
+                if (ref_status != napi.napi_ok or signal_value == null) return false;
+                return AbortSignal.from_raw(self.env, signal_value).isAborted() catch false;
+            }
+            return false;
+        }
+
+        fn requestAbortFromSignal(ptr: ?*anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ptr));
+            self.requestAbort();
+        }
+
+        /// Runs on the JS thread from the abort signal. Lanes stop at their
+        /// next input, and the promise rejects once the last one is out.
+        fn requestAbort(self: *Self) void {
+            self.cancel_token.cancel();
+            if (self.task_done.load(.acquire)) return;
+            self.cancel_requested = true;
+            if (comptime use_wasm_emnapi_async_work) {
+                if (self.async_work != null) {
+                    _ = napi.napi_cancel_async_work(self.env, self.async_work);
+                }
+            }
+        }
+
+        fn queueCompletion(self: *Self) !void {
+            try self.dispatcher.?.post(&self.completion_node);
+        }
+
+        fn runCompletionNode(node: *async_dispatcher.Node, env_raw: napi.napi_env) void {
+            const self: *Self = @alignCast(@fieldParentPtr("completion_node", node));
+            self.dispatchCompletion(env_raw);
+        }
+
+        fn dispatchCompletion(self: *Self, env_raw: napi.napi_env) void {
+            const promise = self.promise;
+            var settled_value: ?napi.napi_value = null;
+            var should_reject = false;
+
+            if (self.cancel_dispatched or self.cancel_requested) {
+                settled_value = AbortSignalModule.abortErrorValue(Env.from_raw(env_raw));
+                should_reject = true;
+            } else if (self.err) |err| {
+                settled_value = err.to_napi_error(Env.from_raw(env_raw));
+                should_reject = true;
+            } else {
+                settled_value = self.output.value(env_raw, self.results) catch |err| blk: {
+                    should_reject = true;
+                    break :blk mapAnyError(err).to_napi_error(Env.from_raw(env_raw));
+                };
+            }
+
+            self.destroy(env_raw);
+
+            if (settled_value) |value| {
+                const status = if (should_reject)
+                    napi.napi_reject_deferred(env_raw, promise.deferred, value)
+                else
+                    napi.napi_resolve_deferred(env_raw, promise.deferred, value);
+                _ = status;
+            }
+        }
+
+        fn attachDispatcher(self: *Self) !void {
+            const dispatcher = try async_dispatcher.Dispatcher.get(self.env);
+            dispatcher.beginOperation();
+            self.dispatcher = dispatcher;
+        }
+
+        fn destroy(self: *Self, env_raw: napi.napi_env) void {
+            if (self.closed) return;
+            self.closed = true;
+            const should_release_threaded_runtime = self.uses_threaded_runtime;
+            self.uses_threaded_runtime = false;
+
+            if (self.abort_registration) |registration| {
+                registration.release();
+                self.abort_registration = null;
+            }
+            if (self.dispatcher) |dispatcher| {
+                dispatcher.endOperation();
+                self.dispatcher = null;
+            }
+            if (self.async_work != null) {
+                _ = napi.napi_delete_async_work(env_raw, self.async_work);
+                self.async_work = null;
+            }
+            self.output.release(env_raw);
+            var deinit_state = Napi.DeinitState{};
+            defer deinit_state.deinit();
+            Napi.deinit_napi_value_with_state(Inputs, self.inputs, &deinit_state);
+            for (self.results, self.ready) |result, ready| {
+                if (ready) Napi.deinit_napi_value_with_state(Result, result, &deinit_state);
+            }
+            self.allocator.free(self.results);
+            self.allocator.free(self.ready);
+            self.allocator.free(self.lanes);
+            self.allocator.destroy(self);
+            if (should_release_threaded_runtime) {
+                releaseThreadedRuntime();
+            }
+        }
+    };
+}
+
+/// Runs `kernel` over a TypedArray, Buffer or DataView in place, split into
+/// chunks that each start on a cache-line boundary, and resolves one promise.
+///
+/// The input is pinned with a strong reference until the promise settles,
+/// and the kernel works on its backing memory directly. Chunks are claimed
+/// one atomic increment at a time by the pool workers, so a worker that
+/// finishes early takes over chunks a slower one has not reached. With a
+/// non-void `Result`, `reduce` folds the per-chunk results in input order,
+/// so the resolved value does not depend on scheduling. Do not detach or
+/// transfer the input's ArrayBuffer while the promise is pending.
+pub fn AsyncParallel(comptime Element: type, comptime Result: type) type {
+    comptime options.requireNapiVersion(.v4);
+    if (!typedarray.isSupportedElementType(Element)) {
+        @compileError("AsyncParallel element must be a TypedArray element type, got: " ++ @typeName(Element));
+    }
+    if (!isPlainParallelResult(Result)) {
+        @compileError("AsyncParallel result must be void, a number, a bool, or a struct of those, got: " ++ @typeName(Result));
+    }
+
+    return struct {
+        pub const is_napi_async_descriptor = true;
+        pub const async_result_type = Result;
+        pub const async_event_type = void;
+        pub const async_runtime_model = RuntimeModel.thread;
+        pub const async_has_events = false;
+
+        base: *AsyncTaskDescriptorBase,
+
+        const Self = @This();
+
+        /// Runs `kernel(chunk: []Element, offset: usize)` on every chunk.
+        /// `offset` is the index of `chunk[0]` within the whole input.
+        pub fn from(input: anytype, comptime kernel: anytype) Self {
+            if (Result != void) {
+                @compileError("AsyncParallel with a result needs a reduce function; use fromWithReduce");
+            }
+            return fromWithParallelism(input, 0, kernel, null);
+        }
+
+        /// Combines the chunk results with `reduce(Result, Result) Result`.
+        pub fn fromWithReduce(input: anytype, comptime kernel: anytype, comptime reduce: anytype) Self {
+            return fromWithParallelism(input, 0, kernel, reduce);
+        }
+
+        /// Uses at most `parallelism` workers. 0 picks the default.
+        pub fn fromWithParallelism(input: anytype, parallelism: usize, comptime kernel: anytype, comptime reduce: anytype) Self {
+            const Input = @TypeOf(input);
+            // Buffers and DataViews may be viewed as any element type.
+            if (ParallelElement(Input) != Element and comptime helper.isTypedArray(Input)) {
+                @compileError("AsyncParallel(" ++ @typeName(Element) ++ ") cannot run over " ++ @typeName(Input));
+            }
+            validateParallelKernel(Element, Result, kernel, reduce);
+
+            const allocator = GlobalAllocator.globalAllocator();
+            const Impl = AsyncParallelDescriptorImpl(Input, Element, Result, kernel, reduce);
+            var impl = allocator.create(Impl) catch @panic("OOM");
+            impl.* = .{
+                .base = .{
+                    .allocator = allocator,
+                    .schedule_fn = Impl.schedule,
+                    .destroy_fn = Impl.destroy,
+                },
+                .input = input,
+                .parallelism = parallelism,
+            };
+            return .{ .base = &impl.base };
+        }
+
+        pub fn schedule(self: *Self, env: Env) !Promise {
+            return try self.scheduleWithListenerAndSignal(env, null, null);
+        }
+
+        pub fn scheduleWithSignal(self: *Self, env: Env, signal: ?AbortSignal) !Promise {
+            return try self.scheduleWithListenerAndSignal(env, null, signal);
+        }
+
+        pub fn scheduleWithListenerAndSignal(self: *Self, env: Env, listener: ?napi.napi_value, signal: ?AbortSignal) !Promise {
+            const base = self.base;
+            return try base.schedule_fn(base, env.raw, listener, signal);
+        }
+
+        pub fn deinit(self: *Self) void {
+            self.base.destroy_fn(self.base);
+        }
+    };
+}
+
+/// `AsyncParallel(Element, void).from(input, kernel)` with the element type
+/// taken from the input; Buffers and DataViews run over bytes.
+pub fn parallelFor(input: anytype, comptime kernel: anytype) AsyncParallel(ParallelElement(@TypeOf(input)), void) {
+    return AsyncParallel(ParallelElement(@TypeOf(input)), void).from(input, kernel);
+}
+
+fn ParallelElement(comptime Input: type) type {
+    if (comptime helper.isTypedArray(Input)) return Input.element_type;
+    if (Input == Buffer or Input == DataView) return u8;
+    @compileError("AsyncParallel input must be a TypedArray, Buffer or DataView, got: " ++ @typeName(Input));
+}
+
+fn isPlainParallelResult(comptime T: type) bool {
+    return switch (@typeInfo(T)) {
+        .void, .bool, .int, .float => true,
+        .@"struct" => |info| blk: {
+            for (info.fields) |field| {
+                if (!isPlainParallelResult(field.type)) break :blk false;
+            }
+            break :blk true;
+        },
+        else => false,
+    };
+}
+
+fn validateParallelKernel(comptime Element: type, comptime Result: type, comptime kernel: anytype, comptime reduce: anytype) void {
+    const kernel_info = @typeInfo(@TypeOf(kernel));
+    if (kernel_info != .@"fn" or kernel_info.@"fn".params.len != 2 or
+        kernel_info.@"fn".params[0].type.? != []Element or kernel_info.@"fn".params[1].type.? != usize)
+    {
+        @compileError("AsyncParallel kernel must be fn (chunk: []" ++ @typeName(Element) ++ ", offset: usize) Result or !Result");
+    }
+    const kernel_return = kernel_info.@"fn".return_type.?;
+    const kernel_result = switch (@typeInfo(kernel_return)) {
+        .error_union => |error_union| error_union.payload,
+        else => kernel_return,
+    };
+    if (kernel_result != Result) {
+        @compileError("AsyncParallel kernel must return " ++ @typeName(Result) ++ ", got: " ++ @typeName(kernel_return));
+    }
+
+    if (@TypeOf(reduce) == @TypeOf(null)) {
+        if (Result != void) @compileError("AsyncParallel with a result needs a reduce function");
+        return;
+    }
+    if (@TypeOf(reduce) != fn (Result, Result) Result) {
+        @compileError("AsyncParallel reduce must be fn (" ++ @typeName(Result) ++ ", " ++ @typeName(Result) ++ ") " ++ @typeName(Result));
+    }
+}
+
+/// Aligned chunks are this many per worker, so fast workers have chunks
+/// left to take from slow ones.
+const parallel_chunks_per_lane = 4;
+
+fn ParallelChunk(comptime Element: type) type {
+    return struct {
+        ptr: [*]Element,
+        len: usize,
+        offset: usize,
+    };
+}
+
+/// Splits `elements` into chunks of whole cache lines. Elements before the
+/// first line boundary ride along with chunk 0, so every later chunk starts
+/// on its own line and no two workers write to the same one. There is
+/// always at least one chunk, so a reduce sees the kernel's result for an
+/// empty input instead of nothing.
+fn splitParallelChunks(comptime Element: type, allocator: std.mem.Allocator, elements: []Element, lanes: usize) ![]ParallelChunk(Element) {
+    const line = std.atomic.cache_line;
+    const line_elements = @max(1, line / @sizeOf(Element));
+    const lead_bytes = (line - @intFromPtr(elements.ptr) % line) % line;
+    const lead = if (lead_bytes % @sizeOf(Element) == 0) @min(elements.len, lead_bytes / @sizeOf(Element)) else 0;
+    const rest = elements.len - lead;
+
+    const target = std.math.divCeil(usize, rest, @max(lanes, 1) * parallel_chunks_per_lane) catch unreachable;
+    const chunk_len = std.mem.alignForward(usize, @max(target, 1), line_elements);
+    const count = @max(1, std.math.divCeil(usize, rest, chunk_len) catch unreachable);
+
+    const chunks = try allocator.alloc(ParallelChunk(Element), count);
+    var start: usize = 0;
+    for (chunks, 0..) |*chunk, index| {
+        const end = if (index + 1 == count) elements.len else lead + (index + 1) * chunk_len;
+        chunk.* = .{ .ptr = elements.ptr + start, .len = end - start, .offset = start };
+        start = end;
+    }
+    return chunks;
+}
+
+/// Views the input as `[]Element`. Buffers and DataViews must hold a whole
+/// number of aligned elements.
+fn parallelElements(comptime Element: type, input: anytype) ![]Element {
+    const Input = @TypeOf(input);
+    if (comptime helper.isTypedArray(Input)) return input.asSlice();
+
+    const bytes = input.asSlice();
+    if (Element == u8) return bytes;
+    if (bytes.len % @sizeOf(Element) != 0 or @intFromPtr(bytes.ptr) % @alignOf(Element) != 0) {
+        return NapiError.Error.fromReason("AsyncParallel input is not a whole number of aligned " ++ @typeName(Element) ++ " elements");
+    }
+    return @alignCast(std.mem.bytesAsSlice(Element, bytes));
+}
+
+fn AsyncParallelDescriptorImpl(
+    comptime Input: type,
+    comptime Element: type,
+    comptime Result: type,
+    comptime kernel: anytype,
+    comptime reduce: anytype,
+) type {
+    return struct {
+        base: AsyncTaskDescriptorBase,
+        input: Input,
+        parallelism: usize,
+
+        const Self = @This();
+        const Chunk = ParallelChunk(Element);
+        const Output = ParallelOutput(Input, Result, reduce);
+        const Operation = AsyncBatchOperation([]Chunk, Result, .thread, runChunk, Output);
+
+        fn runChunk(chunk: Chunk) @typeInfo(@TypeOf(kernel)).@"fn".return_type.? {
+            return kernel(chunk.ptr[0..chunk.len], chunk.offset);
+        }
+
+        fn schedule(base: *AsyncTaskDescriptorBase, env_raw: napi.napi_env, _: ?napi.napi_value, signal: ?AbortSignal) !Promise {
+            const self: *Self = @alignCast(@fieldParentPtr("base", base));
+            errdefer base.destroy_fn(base);
+
+            const operation = blk: {
+                const lanes = if (self.parallelism == 0) defaultBatchParallelism() else self.parallelism;
+                const elements = try parallelElements(Element, self.input);
+                const chunks = try splitParallelChunks(Element, self.base.allocator, elements, lanes);
+                errdefer self.base.allocator.free(chunks);
+
+                var input_ref: napi.napi_ref = null;
+                try checkStatus(napi.napi_create_reference(env_raw, self.input.raw, 1, &input_ref));
+                errdefer _ = napi.napi_delete_reference(env_raw, input_ref);
+
+                break :blk try Operation.create(Env.from_raw(env_raw), chunks, lanes, signal, .{
+                    .input = self.input,
+                    .input_ref = input_ref,
+                });
+            };
+            const promise = try operation.submit();
+            base.destroy_fn(base);
+            return promise;
+        }
+
+        fn destroy(base: *AsyncTaskDescriptorBase) void {
+            const self: *Self = @alignCast(@fieldParentPtr("base", base));
+            self.base.allocator.destroy(self);
+        }
+    };
+}
+
+/// Holds the input alive while the chunks run, then folds their results.
+fn ParallelOutput(comptime Input: type, comptime Result: type, comptime reduce: anytype) type {
+    return struct {
+        input: Input,
+        input_ref: napi.napi_ref,
+
+        fn value(self: *@This(), env_raw: napi.napi_env, results: []Result) !napi.napi_value {
+            // On wasm the kernel wrote to a copy in linear memory. The handle
+            // captured at the call belongs to a closed scope, so flush
+            // through the pinned reference.
+            var input = self.input;
+            input.env = env_raw;
+            try checkStatus(napi.napi_get_reference_value(env_raw, self.input_ref, &input.raw));
+            try input.flush();
+            if (Result == void) {
+                return Undefined.New(Env.from_raw(env_raw)).raw;
+            } else {
+                var total = results[0];
+                for (results[1..]) |partial| total = reduce(total, partial);
+                return try Napi.to_napi_value(env_raw, total, null);
+            }
+        }
+
+        fn release(self: *@This(), env_raw: napi.napi_env) void {
+            _ = napi.napi_delete_reference(env_raw, self.input_ref);
+        }
+    };
+}
+
+/// Streams the events of `run_fn` to JavaScript through an async iterator.
+/// The returned promise resolves to an object that implements
+/// `Symbol.asyncIterator`, so `for await (const event of stream)` pulls
+/// events one by one.
+///
+/// `ctx.emit(event)` writes into a bounded buffer and suspends the producer
+/// on its `std.Io` runtime while the buffer is full, so a fast producer
+/// cannot run ahead of the consumer. Each `next()` that finds the local
+/// queue empty moves everything buffered at once to the JS thread. `return()`
+/// (leaving the loop early), an `AbortSignal` parameter, or the iterator being
+/// collected cancels the producer.
+pub fn AsyncStream(comptime Event: type, comptime runtime: RuntimeModel) type {
+    comptime options.requireNapiVersion(.v4);
+    if (Event == void) {
+        @compileError("AsyncStream needs a non-void Event");
+    }
+    if (effectiveRuntime(runtime) != .thread) {
+        @compileError("AsyncStream needs the .thread runtime: a single-threaded producer cannot wait for JavaScript to drain its buffer");
+    }
+
+    return struct {
+        pub const is_napi_async_descriptor = true;
+        pub const is_napi_async_stream = true;
+        pub const async_result_type = void;
+        pub const async_event_type = Event;
+        pub const async_runtime_model = runtime;
+        pub const async_has_events = false;
+        pub const default_capacity = 64;
+
+        base: *AsyncTaskDescriptorBase,
+
+        const Self = @This();
+
+        pub fn from(input: anytype, comptime run_fn: anytype) Self {
+            return fromWithCapacity(input, default_capacity, run_fn);
+        }
+
+        /// `capacity` is the number of events buffered before the producer
+        /// waits.
+        pub fn fromWithCapacity(input: anytype, capacity: usize, comptime run_fn: anytype) Self {
+            const Input = @TypeOf(input);
+            validateTaskRunSignature(Input, void, Event, run_fn);
+            if (@typeInfo(@TypeOf(run_fn)).@"fn".params.len != 2) {
+                @compileError("AsyncStream runner must accept (AsyncContext(Event), input)");
+            }
+
+            const allocator = GlobalAllocator.globalAllocator();
+            const Impl = AsyncStreamDescriptorImpl(Input, Event, run_fn);
+            var impl = allocator.create(Impl) catch @panic("OOM");
+            impl.* = .{
+                .base = .{
+                    .allocator = allocator,
+                    .schedule_fn = Impl.schedule,
+                    .destroy_fn = Impl.destroy,
+                },
+                .input = input,
+                .capacity = @max(capacity, 1),
+            };
+            return .{ .base = &impl.base };
+        }
+
+        pub fn schedule(self: *Self, env: Env) !Promise {
+            return try self.scheduleWithListenerAndSignal(env, null, null);
+        }
+
+        pub fn scheduleWithSignal(self: *Self, env: Env, signal: ?AbortSignal) !Promise {
+            return try self.scheduleWithListenerAndSignal(env, null, signal);
+        }
+
+        pub fn scheduleWithListenerAndSignal(self: *Self, env: Env, listener: ?napi.napi_value, signal: ?AbortSignal) !Promise {
+            const base = self.base;
+            return try base.schedule_fn(base, env.raw, listener, signal);
+        }
+
+        pub fn deinit(self: *Self) void {
+            self.base.destroy_fn(self.base);
+        }
+    };
+}
+
+fn AsyncStreamDescriptorImpl(comptime Input: type, comptime Event: type, comptime run_fn: anytype) type {
+    return struct {
+        base: AsyncTaskDescriptorBase,
+        input: Input,
+        capacity: usize,
+        input_moved: bool = false,
+
+        const Self = @This();
+
+        fn schedule(base: *AsyncTaskDescriptorBase, env_raw: napi.napi_env, _: ?napi.napi_value, signal: ?AbortSignal) !Promise {
+            const self: *Self = @alignCast(@fieldParentPtr("base", base));
+            errdefer base.destroy_fn(base);
+            const operation = try AsyncStreamOperation(Input, Event, run_fn).create(Env.from_raw(env_raw), self.input, self.capacity, signal);
+            self.input_moved = true;
+            const promise = try operation.submit();
+            base.destroy_fn(base);
+            return promise;
+        }
+
+        fn destroy(base: *AsyncTaskDescriptorBase) void {
+            const self: *Self = @alignCast(@fieldParentPtr("base", base));
+            if (!self.input_moved) {
+                Napi.deinit_napi_value(Input, self.input);
+            }
+            self.base.allocator.destroy(self);
+        }
+    };
+}
+
+fn AsyncStreamOperation(comptime Input: type, comptime Event: type, comptime run_fn: anytype) type {
+    return struct {
+        allocator: std.mem.Allocator,
+        env: napi.napi_env,
+        promise: Promise,
+        input: Input,
+        io: std.Io = undefined,
+
+        /// Shared with the producer; guarded by `mutex`.
+        mutex: std.Io.Mutex = .init,
+        not_full: std.Io.Condition = .init,
+        buffer: []Event,
+        buffer_head: usize = 0,
+        buffer_len: usize = 0,
+        consumer_waiting: bool = false,
+
+        /// JS thread only: events taken from `buffer` but not yet handed out,
+        /// and `next()` promises waiting for an event.
+        local: []Event,
+        local_head: usize = 0,
+        local_len: usize = 0,
+        pending: std.ArrayList(napi.napi_deferred) = .empty,
+        producer_done: bool = false,
+        finished_delivered: bool = false,
+        iterator_alive: bool = false,
+        /// Iteration ended from JS: remaining `next()` calls report done.
+        returned: bool = false,
+        aborted: bool = false,
+
+        err: ?NapiError.Error = null,
+        abort_registration: ?*AbortRegistration = null,
+        cancel_token: CancelToken = .{},
+        thread_job: ThreadJob = .{ .run = runThreadJob },
+        async_work: napi.napi_async_work = null,
+        dispatcher: ?*async_dispatcher.Dispatcher = null,
+        wake_node: async_dispatcher.Node = .{ .run = runWakeNode },
+        wake_posted: std.atomic.Value(bool) = .init(false),
+        park_node: async_dispatcher.Node = .{ .run = runParkNode },
+        park_posted: std.atomic.Value(bool) = .init(false),
+        /// JS thread only: the operation's hold on the event loop is dropped
+        /// while the producer waits on a full buffer nobody is reading.
+        loop_released: bool = false,
+        completion_node: async_dispatcher.Node = .{ .run = runCompletionNode },
+        closed: bool = false,
+        uses_threaded_runtime: bool = false,
+
+        const Self = @This();
+        const Context = AsyncContext(Event);
+
+        fn create(env: Env, input: Input, capacity: usize, signal: ?AbortSignal) !*Self {
+            const allocator = GlobalAllocator.globalAllocator();
+            const self = try allocator.create(Self);
+            errdefer allocator.destroy(self);
+
+            const buffer = try allocator.alloc(Event, capacity);
+            errdefer allocator.free(buffer);
+            const local = try allocator.alloc(Event, capacity);
+            errdefer allocator.free(local);
+
+            self.* = .{
+                .allocator = allocator,
+                .env = env.raw,
+                .promise = Promise.New(env),
+                .input = input,
+                .buffer = buffer,
+                .local = local,
+            };
+
+            if (signal) |abort_signal| {
+                self.abort_registration = try abort_signal.bind(@ptrCast(self), requestAbortFromSignal);
+            }
+
+            return self;
+        }
+
+        fn submit(self: *Self) !Promise {
+            errdefer self.destroy(self.env);
+
+            const promise = self.promise;
+            if (self.abort_registration != null and self.isAbortRequestedFromSignal()) {
+                self.promise.RejectAbortError() catch {};
+                self.destroy(self.env);
+                return promise;
+            }
+
+            try self.attachDispatcher();
+            if (comptime use_wasm_emnapi_async_work) {
+                self.io = singleIo();
+            } else {
+                try acquireThreadedRuntime(self.env);
+                self.uses_threaded_runtime = true;
+                self.io = activeThreadedIo();
+            }
+
+            // Wrapping is the last fallible step; from here on the iterator
+            // finalizer co-owns the stream.
+            const iterator = try self.createIterator();
+            self.iterator_alive = true;
+            self.start();
+
+            _ = napi.napi_resolve_deferred(self.env, promise.deferred, iterator);
+            return promise;
+        }
+
+        fn start(self: *Self) void {
+            if (comptime use_wasm_emnapi_async_work) {
+                self.runWasmAsyncWork() catch |err| {
+                    self.err = mapAnyError(err);
+                    self.complete(self.env);
+                };
+            } else {
+                submitThreadJob(&self.thread_job) catch |err| {
+                    self.err = mapAnyError(err);
+                    self.complete(self.env);
+                };
+            }
+        }
+
+        fn createIterator(self: *Self) !napi.napi_value {
+            var iterator: napi.napi_value = undefined;
+            try checkStatus(napi.napi_create_object(self.env, &iterator));
+
+            const methods = [_]napi.napi_property_descriptor{
+                .{ .utf8name = "next", .name = null, .method = next, .getter = null, .setter = null, .value = null, .attributes = napi.napi_default, .data = self },
+                .{ .utf8name = "return", .name = null, .method = returnMethod, .getter = null, .setter = null, .value = null, .attributes = napi.napi_default, .data = self },
+            };
+            try checkStatus(napi.napi_define_properties(self.env, iterator, methods.len, &methods));
+
+            // iterator[Symbol.asyncIterator] = function () { return this; }
+            var global: napi.napi_value = undefined;
+            var symbol_ctor: napi.napi_value = undefined;
+            var async_iterator_key: napi.napi_value = undefined;
+            var self_fn: napi.napi_value = undefined;
+            try checkStatus(napi.napi_get_global(self.env, &global));
+            try checkStatus(napi.napi_get_named_property(self.env, global, "Symbol", &symbol_ctor));
+            try checkStatus(napi.napi_get_named_property(self.env, symbol_ctor, "asyncIterator", &async_iterator_key));
+            try checkStatus(napi.napi_create_function(self.env, "asyncIterator", "asyncIterator".len, returnThis, null, &self_fn));
+            try checkStatus(napi.napi_set_property(self.env, iterator, async_iterator_key, self_fn));
+
+            try checkStatus(napi.napi_wrap(self.env, iterator, self, finalizeIterator, null, null));
+            return iterator;
+        }
+
+        fn runThreadJob(job: *ThreadJob) void {
+            const self: *Self = @alignCast(@fieldParentPtr("thread_job", job));
+            self.runProducer();
+            self.queueCompletion() catch {};
+        }
+
+        fn runProducer(self: *Self) void {
+            var group: std.Io.Group = .init;
+            defer group.cancel(self.io);
+
+            const context = Context{
+                .allocator = self.allocator,
+                .io = self.io,
+                .group = &group,
+                .runtime = .thread,
+                .effective_runtime = .thread,
+                .cancel_token = &self.cancel_token,
+                .emitter_ptr = @ptrCast(self),
+                .emit_fn = emitFromContext,
+            };
+
+            NapiError.clearLastError();
+            const ret = run_fn(context, self.input);
+            if (@typeInfo(@TypeOf(ret)) == .error_union) {
+                ret catch |err| {
+                    self.err = mapAnyError(err);
+                    return;
+                };
+            }
+            if (self.cancel_token.isCancelled()) return;
+            group.await(self.io) catch |err| {
+                self.err = mapAnyError(err);
+            };
+        }
+
+        /// Producer side: waits while the buffer is full.
+        fn emitFromContext(ptr: ?*anyopaque, event: Event) anyerror!void {
+            const self: *Self = @ptrCast(@alignCast(ptr));
+
+            try self.mutex.lock(self.io);
+            var wake = false;
+            {
+                defer self.mutex.unlock(self.io);
+                while (self.buffer_len == self.buffer.len) {
+                    try self.cancel_token.check();
+                    self.postPark();
+                    try self.not_full.wait(self.io, &self.mutex);
+                }
+                try self.cancel_token.check();
+
+                self.buffer[(self.buffer_head + self.buffer_len) % self.buffer.len] = event;
+                self.buffer_len += 1;
+                wake = self.consumer_waiting;
+                self.consumer_waiting = false;
+            }
+            if (wake) try self.postWake();
+        }
+
+        fn postWake(self: *Self) !void {
+            if (self.wake_posted.swap(true, .acq_rel)) return;
+            try self.dispatcher.?.post(&self.wake_node);
+        }
+
+        fn runWakeNode(node: *async_dispatcher.Node, env_raw: napi.napi_env) void {
+            const self: *Self = @alignCast(@fieldParentPtr("wake_node", node));
+            self.wake_posted.store(false, .release);
+            self.service(env_raw);
+        }
+
+        /// Producer side, called before waiting for room. A lost post only
+        /// keeps the event loop referenced, so failures are ignored.
+        fn postPark(self: *Self) void {
+            if (self.park_posted.swap(true, .acq_rel)) return;
+            self.dispatcher.?.post(&self.park_node) catch {};
+        }
+
+        /// A producer parked on a full buffer only moves again once `next()`
+        /// is called, so it must not keep the process alive on its own.
+        fn runParkNode(node: *async_dispatcher.Node, _: napi.napi_env) void {
+            const self: *Self = @alignCast(@fieldParentPtr("park_node", node));
+            self.park_posted.store(false, .release);
+            if (self.loop_released or self.pending.items.len > 0) return;
+            const dispatcher = self.dispatcher orelse return;
+
+            self.mutex.lockUncancelable(self.io);
+            const full = self.buffer_len == self.buffer.len;
+            self.mutex.unlock(self.io);
+            if (!full) return;
+
+            dispatcher.endOperation();
+            self.loop_released = true;
+        }
+
+        /// Takes the event loop hold back before `next()` refills.
+        fn holdLoop(self: *Self) void {
+            if (!self.loop_released) return;
+            self.loop_released = false;
+            if (self.dispatcher) |dispatcher| dispatcher.beginOperation();
+        }
+
+        /// Moves everything buffered to the JS-thread queue in one lock
+        /// round, and wakes the producer if it was waiting for room.
+        fn refill(self: *Self) void {
+            self.mutex.lockUncancelable(self.io);
+            defer self.mutex.unlock(self.io);
+
+            const count = self.buffer_len;
+            for (0..count) |i| {
+                self.local[i] = self.buffer[(self.buffer_head + i) % self.buffer.len];
+            }
+            self.buffer_head = (self.buffer_head + count) % self.buffer.len;
+            self.buffer_len = 0;
+            self.local_head = 0;
+            self.local_len = count;
+
+            if (count > 0) {
+                self.not_full.broadcast(self.io);
+            } else {
+                self.consumer_waiting = true;
+            }
+        }
+
+        /// Settles waiting `next()` promises in order. JS thread only.
+        fn service(self: *Self, env_raw: napi.napi_env) void {
+            while (self.pending.items.len > 0) {
+                if (self.local_len == 0 and !self.cancel_token.isCancelled()) self.refill();
+
+                if (self.local_len > 0) {
+                    const event = self.local[self.local_head];
+                    self.local_head += 1;
+                    self.local_len -= 1;
+                    const deferred = self.pending.orderedRemove(0);
+                    const value = Napi.to_napi_value(env_raw, event, null) catch |err| {
+                        _ = napi.napi_reject_deferred(env_raw, deferred, mapAnyError(err).to_napi_error(Env.from_raw(env_raw)));
+                        continue;
+                    };
+                    _ = napi.napi_resolve_deferred(env_raw, deferred, iteratorResult(env_raw, value, false));
+                    continue;
+                }
+
+                if (!self.producer_done) return;
+
+                const deferred = self.pending.orderedRemove(0);
+                const env = Env.from_raw(env_raw);
+                if (self.finished_delivered or self.returned) {
+                    _ = napi.napi_resolve_deferred(env_raw, deferred, iteratorResult(env_raw, null, true));
+                } else if (self.aborted) {
+                    _ = napi.napi_reject_deferred(env_raw, deferred, AbortSignalModule.abortErrorValue(env));
+                } else if (self.err) |err| {
+                    _ = napi.napi_reject_deferred(env_raw, deferred, err.to_napi_error(env));
+                } else {
+                    _ = napi.napi_resolve_deferred(env_raw, deferred, iteratorResult(env_raw, null, true));
+                }
+                self.finished_delivered = true;
+            }
+        }
+
+        fn next(env_raw: napi.napi_env, info: napi.napi_callback_info) callconv(.c) napi.napi_value {
+            const self = callbackData(env_raw, info) orelse return null;
+
+            var deferred: napi.napi_deferred = null;
+            var promise: napi.napi_value = null;
+            if (napi.napi_create_promise(env_raw, &deferred, &promise) != napi.napi_ok) return null;
+            self.pending.append(self.allocator, deferred) catch @panic("OOM");
+            self.holdLoop();
+            self.service(env_raw);
+            return promise;
+        }
+
+        /// `for await` calls this when the loop exits early.
+        fn returnMethod(env_raw: napi.napi_env, info: napi.napi_callback_info) callconv(.c) napi.napi_value {
+            const self = callbackData(env_raw, info) orelse return null;
+            self.returned = true;
+            self.cancelProducer();
+            self.local_len = 0;
+
+            var deferred: napi.napi_deferred = null;
+            var promise: napi.napi_value = null;
+            if (napi.napi_create_promise(env_raw, &deferred, &promise) != napi.napi_ok) return null;
+            _ = napi.napi_resolve_deferred(env_raw, deferred, iteratorResult(env_raw, null, true));
+            return promise;
+        }
+
+        fn returnThis(env_raw: napi.napi_env, info: napi.napi_callback_info) callconv(.c) napi.napi_value {
+            var this: napi.napi_value = null;
+            _ = napi.napi_get_cb_info(env_raw, info, null, null, &this, null);
+            return this;
+        }
+
+        fn callbackData(env_raw: napi.napi_env, info: napi.napi_callback_info) ?*Self {
+            var data: ?*anyopaque = null;
+            if (napi.napi_get_cb_info(env_raw, info, null, null, null, &data) != napi.napi_ok) return null;
+            return @ptrCast(@alignCast(data orelse return null));
+        }
+
+        fn iteratorResult(env_raw: napi.napi_env, value: ?napi.napi_value, done: bool) napi.napi_value {
+            var result: napi.napi_value = null;
+            var done_value: napi.napi_value = null;
+            var undefined_value: napi.napi_value = null;
+            _ = napi.napi_create_object(env_raw, &result);
+            _ = napi.napi_get_boolean(env_raw, done, &done_value);
+            _ = napi.napi_get_undefined(env_raw, &undefined_value);
+            _ = napi.napi_set_named_property(env_raw, result, "value", value orelse undefined_value);
+            _ = napi.napi_set_named_property(env_raw, result, "done", done_value);
+            return result;
+        }
+
+        /// Stops the producer at its next `emit` or cancellation check.
+        fn cancelProducer(self: *Self) void {
+            self.cancel_token.cancel();
+            if (self.producer_done) return;
+            self.mutex.lockUncancelable(self.io);
+            defer self.mutex.unlock(self.io);
+            self.not_full.broadcast(self.io);
+        }
+
+        fn finalizeIterator(_: napi.napi_env, data: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(data orelse return));
+            self.iterator_alive = false;
+            self.returned = true;
+            self.cancelProducer();
+            if (self.producer_done) self.destroy(self.env);
+        }
+
+        fn runWasmAsyncWork(self: *Self) !void {
+            const resource_name = String.New(Env.from_raw(self.env), "ZigAsyncStream");
+            var async_work: napi.napi_async_work = null;
+            try checkStatus(napi.napi_create_async_work(
+                self.env,
+                null,
+                resource_name.raw,
+                wasmAsyncWorkExecute,
+                wasmAsyncWorkComplete,
+                @ptrCast(self),
+                &async_work,
+            ));
+            self.async_work = async_work;
+
+            const queue_status = napi.napi_queue_async_work(self.env, async_work);
+            if (queue_status != napi.napi_ok) {
+                _ = napi.napi_delete_async_work(self.env, async_work);
+                self.async_work = null;
+                return NapiError.Error.fromStatus(NapiError.Status.New(queue_status));
+            }
+        }
+
+        fn wasmAsyncWorkExecute(_: napi.napi_env, data: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(data));
+            self.runProducer();
+        }
+
+        fn wasmAsyncWorkComplete(inner_env: napi.napi_env, _: napi.napi_status, data: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(data));
+            if (self.async_work != null) {
+                _ = napi.napi_delete_async_work(inner_env, self.async_work);
+                self.async_work = null;
+            }
+            // Already on the JS thread: deliver what the producer posted,
+            // then complete without leaving a node queued.
+            if (self.dispatcher) |dispatcher| dispatcher.runPending(inner_env);
+            self.complete(inner_env);
+        }
+
+        fn isAbortRequestedFromSignal(self: *Self) bool {
+            if (self.abort_registration) |registration| {
+                var signal_value: napi.napi_value = undefined;
+                const ref_status = napi.napi_get_reference_value(self.env, registration.signal_ref, &signal_value);
+                if (ref_status != napi.napi_ok or signal_value == null) return false;
+                return AbortSignal.from_raw(self.env, signal_value).isAborted() catch false;
+            }
+            return false;
+        }
+
+        fn requestAbortFromSignal(ptr: ?*anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ptr));
+            if (self.producer_done) return;
+            self.aborted = true;
+            self.cancelProducer();
+        }
+
+        fn queueCompletion(self: *Self) !void {
+            try self.dispatcher.?.post(&self.completion_node);
+        }
+
+        fn runCompletionNode(node: *async_dispatcher.Node, env_raw: napi.napi_env) void {
+            const self: *Self = @alignCast(@fieldParentPtr("completion_node", node));
+            self.complete(env_raw);
+        }
+
+        /// The producer has returned: settle what is waiting, then free the
+        /// stream unless the iterator is still reachable.
+        fn complete(self: *Self, env_raw: napi.napi_env) void {
+            self.producer_done = true;
+            self.detachDispatcher();
+            if (self.abort_registration) |registration| {
+                registration.release();
+                self.abort_registration = null;
+            }
+            self.service(env_raw);
+            if (!self.iterator_alive) self.destroy(env_raw);
+        }
+
+        fn attachDispatcher(self: *Self) !void {
+            const dispatcher = try async_dispatcher.Dispatcher.get(self.env);
+            dispatcher.beginOperation();
+            self.dispatcher = dispatcher;
+        }
+
+        fn detachDispatcher(self: *Self) void {
+            const dispatcher = self.dispatcher orelse return;
+            self.dispatcher = null;
+            if (self.loop_released) {
+                self.loop_released = false;
+                return;
+            }
+            dispatcher.endOperation();
+        }
+
+        fn destroy(self: *Self, env_raw: napi.napi_env) void {
+            if (self.closed) return;
+            self.closed = true;
+            const should_release_threaded_runtime = self.uses_threaded_runtime;
+            self.uses_threaded_runtime = false;
+
+            if (self.abort_registration) |registration| {
+                registration.release();
+                self.abort_registration = null;
+            }
+            self.detachDispatcher();
+            if (self.async_work != null) {
+                _ = napi.napi_delete_async_work(env_raw, self.async_work);
+                self.async_work = null;
+            }
+            Napi.deinit_napi_value(Input, self.input);
+            self.pending.deinit(self.allocator);
+            self.allocator.free(self.buffer);
+            self.allocator.free(self.local);
+            self.allocator.destroy(self);
+            if (should_release_threaded_runtime) {
+                releaseThreadedRuntime();
+            }
+        }
+    };
+}
+
+fn checkStatus(status: napi.napi_status) !void {
+    if (status != napi.napi_ok) {
+        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+    }
+}
+
+test "Async descriptor exposes runtime metadata" {
+    const Task = Async(u32, .thread);
+    try std.testing.expect(Task.is_napi_async_descriptor);
+    try std.testing.expect(Task.async_result_type == u32);
+    try std.testing.expect(Task.async_event_type == void);
+    try std.testing.expect(Task.async_runtime_model == .thread);
+}
+
+test "AsyncWithEvents descriptor marks callback support" {
+    const Event = struct { current: u32 };
+    const Task = AsyncWithEvents(u32, Event, .single);
+    try std.testing.expect(Task.async_has_events);
     try std.testing.expect(Task.async_event_type == Event);
 }
+
+test "AsyncBatch settles numeric results as a TypedArray" {
+    const Numbers = AsyncBatch(f64, .thread);
+    try std.testing.expect(Numbers.is_napi_async_descriptor);
+    try std.testing.expect(Numbers.packed_results);
+    try std.testing.expect(Numbers.async_result_type == typedarray.TypedArray(f64));
+
+    const Structs = AsyncBatch(struct { id: u32 }, .single);
+    try std.testing.expect(!Structs.packed_results);
+    try std.testing.expect(!Structs.async_has_events);
+}
+
+test "splitParallelChunks starts every chunk after the first on a cache line" {
+    const line = std.atomic.cache_line;
+    var storage: [line * 8 + 3]u8 align(line) = undefined;
+    const elements = storage[3..];
+
+    const chunks = try splitParallelChunks(u8, std.testing.allocator, elements, 2);
+    defer std.testing.allocator.free(chunks);
+
+    var covered: usize = 0;
+    for (chunks, 0..) |chunk, index| {
+        try std.testing.expectEqual(covered, chunk.offset);
+        if (index != 0) try std.testing.expectEqual(@as(usize, 0), @intFromPtr(chunk.ptr) % line);
+        covered += chunk.len;
+    }
+    try std.testing.expectEqual(elements.len, covered);
+
+    const empty = try splitParallelChunks(f32, std.testing.allocator, &.{}, 4);
+    defer std.testing.allocator.free(empty);
+    try std.testing.expectEqual(@as(usize, 1), empty.len);
+    try std.testing.expectEqual(@as(usize, 0), empty[0].len);
+}
+
+test "AsyncStream descriptor is marked for async iteration" {
+    const Stream = AsyncStream(u32, .thread);
+    try std.testing.expect(Stream.is_napi_async_descriptor);
+    try std.testing.expect(Stream.is_napi_async_stream);
+    try std.testing.expect(Stream.async_event_type == u32);
+    try std.testing.expect(!Stream.async_has_events);
+}
+
+test "AsyncWithEventPolicy exposes what the listener receives" {
+    const Progress = struct { current: u32 };
+    try std.testing.expect(AsyncWithEventPolicy(u32, Progress, .thread, .latest).async_event_type == Progress);
+    try std.testing.expect(AsyncWithEventPolicy(u32, Progress, .thread, .{ .coalesce = 8 }).async_event_type == []const Progress);
+}
+
+test "CoalescedEvents keeps the newest events in order" {
+    var ring: CoalescedEvents(u32, 3) = .{};
+    try std.testing.expectEqual(EventWake.now, ring.store(1));
+    try std.testing.expectEqual(EventWake.none, ring.store(2));
+    _ = ring.store(3);
+    _ = ring.store(4);
+
+    var taken: [3]u32 = undefined;
+    try std.testing.expectEqualSlices(u32, &.{ 2, 3, 4 }, ring.take(&taken).?);
+    try std.testing.expectEqual(@as(?[]const u32, null), ring.take(&taken));
+
+    ring.woken();
+    try std.testing.expectEqual(EventWake.now, ring.store(5));
+}
+
+test "LatestEventSlot asks for a trailing wake-up inside its period" {
+    const period_ns = std.time.ns_per_hour;
+    var slot: LatestEventSlot(u32, period_ns) = .{};
+    try std.testing.expectEqual(EventWake.now, slot.store(1));
+
+    // While the first wake-up is pending, nothing more is asked for.
+    try std.testing.expectEqual(EventWake.none, slot.store(2));
+    slot.woken();
+
+    switch (slot.store(3)) {
+        .after => |delay_ns| try std.testing.expect(delay_ns > 0 and delay_ns <= period_ns),
+        else => return error.TestUnexpectedResult,
+    }
+    try std.testing.expect(slot.expire());
+    try std.testing.expect(!slot.expire());
+
+    var taken: void = {};
+    try std.testing.expectEqual(@as(?u32, 3), slot.take(&taken));
+    try std.testing.expectEqual(@as(?u32, null), slot.take(&taken));
+}
+
+test "ThreadJobQueue hands out jobs in submission order" {
+    const Noop = struct {
+        fn run(_: *ThreadJob) void {}
+    };
+    var jobs = [_]ThreadJob{ .{ .run = Noop.run }, .{ .run = Noop.run }, .{ .run = Noop.run } };
+    var queue: ThreadJobQueue = .{};
+    for (&jobs) |*job| queue.push(job);
+
+    for (&jobs) |*job| try std.testing.expectEqual(@as(?*ThreadJob, job), queue.pop());
+    try std.testing.expectEqual(@as(?*ThreadJob, null), queue.pop());
+
+    queue.push(&jobs[1]);
+    try std.testing.expectEqual(@as(?*ThreadJob, &jobs[1]), queue.pop());
+}
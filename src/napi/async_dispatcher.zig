@@ -0,0 +1,222 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const NapiError = @import("./wrapper/error.zig");
+const GlobalAllocator = @import("./util/allocator.zig");
+const instance_data = @import("./util/instance_data.zig");
+
+/// Work item posted to the JS thread. Embed it in the owning struct and
+/// recover the owner with `@fieldParentPtr` in `run`.
+pub const Node = struct {
+    next: ?*Node = null,
+    /// Runs on the JS thread inside the dispatcher's callback scope. An
+    /// exception it leaves pending is reported as uncaught once it returns,
+    /// so the nodes after it still run.
+    run: *const fn (*Node, napi.napi_env) void,
+};
+
+/// One per env: carries completions and events of every threaded async
+/// operation to the JS thread over a single thread-safe function.
+///
+/// Producers push nodes onto a lock-free intrusive list; only the push that
+/// finds no wake-up in flight calls `napi_call_threadsafe_function`. The JS
+/// thread takes the whole list at once and runs it in FIFO order under one
+/// callback scope, so promise reactions and `process.nextTick` callbacks
+/// drain once per batch instead of once per operation. An exception thrown
+/// by one node is reported as uncaught and does not stop the rest.
+///
+/// The dispatcher is unref'd while no operation is in flight, so an idle
+/// dispatcher never keeps the event loop alive.
+pub const Dispatcher = struct {
+    env: napi.napi_env,
+    tsfn_raw: napi.napi_threadsafe_function = null,
+    resource_ref: napi.napi_ref = null,
+    async_context: napi.napi_async_context = null,
+    head: std.atomic.Value(?*Node) = .init(null),
+    wake_pending: std.atomic.Value(bool) = .init(false),
+    /// JS thread only.
+    operations: usize = 0,
+    closed: bool = false,
+
+    /// Returns the dispatcher of `env`, creating it on first use.
+    pub fn get(env: napi.napi_env) !*Dispatcher {
+        if (Slot.get(env)) |handle| return handle.dispatcher;
+
+        const dispatcher = try create(env);
+        errdefer dispatcher.close(env);
+        _ = try Slot.put(env, .{ .dispatcher = dispatcher });
+        return dispatcher;
+    }
+
+    fn create(env: napi.napi_env) !*Dispatcher {
+        const allocator = GlobalAllocator.runtimeAllocator();
+        const self = allocator.create(Dispatcher) catch @panic("OOM");
+        self.* = .{ .env = env };
+        errdefer allocator.destroy(self);
+
+        var resource: napi.napi_value = undefined;
+        try check(napi.napi_create_object(env, &resource));
+        try check(napi.napi_create_reference(env, resource, 1, &self.resource_ref));
+        errdefer _ = napi.napi_delete_reference(env, self.resource_ref);
+
+        var resource_name: napi.napi_value = undefined;
+        try check(napi.napi_create_string_utf8(env, "ZigAsyncDispatcher", "ZigAsyncDispatcher".len, &resource_name));
+        try check(napi.napi_async_init(env, resource, resource_name, &self.async_context));
+        errdefer _ = napi.napi_async_destroy(env, self.async_context);
+
+        var callback: napi.napi_value = undefined;
+        try check(napi.napi_create_function(env, "zigAsyncDispatcher", "zigAsyncDispatcher".len, noop, null, &callback));
+        try check(napi.napi_create_threadsafe_function(
+            env,
+            callback,
+            null,
+            resource_name,
+            0,
+            1,
+            null,
+            finalize,
+            @ptrCast(self),
+            drain,
+            &self.tsfn_raw,
+        ));
+        // Owned by `finalize` from here on.
+        _ = napi.napi_unref_threadsafe_function(env, self.tsfn_raw);
+        return self;
+    }
+
+    /// Keeps the event loop alive while an operation is in flight. JS thread
+    /// only; pair with `endOperation`.
+    pub fn beginOperation(self: *Dispatcher) void {
+        self.operations += 1;
+        if (self.operations == 1 and !self.closed) {
+            _ = napi.napi_ref_threadsafe_function(self.env, self.tsfn_raw);
+        }
+    }
+
+    pub fn endOperation(self: *Dispatcher) void {
+        std.debug.assert(self.operations > 0);
+        self.operations -= 1;
+        if (self.operations == 0 and !self.closed) {
+            _ = napi.napi_unref_threadsafe_function(self.env, self.tsfn_raw);
+        }
+    }
+
+    /// Queues `node` for the JS thread. Safe from any thread. The node is
+    /// queued even when the wake-up fails; it then runs with the next
+    /// wake-up, so the caller must not free it.
+    pub fn post(self: *Dispatcher, node: *Node) !void {
+        var head = self.head.load(.monotonic);
+        while (true) {
+            node.next = head;
+            head = self.head.cmpxchgWeak(head, node, .release, .monotonic) orelse break;
+        }
+
+        if (self.wake_pending.swap(true, .acq_rel)) return;
+        const status = napi.napi_call_threadsafe_function(self.tsfn_raw, null, napi.napi_tsfn_nonblocking);
+        if (status != napi.napi_ok) {
+            self.wake_pending.store(false, .release);
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+    }
+
+    fn drain(inner_env: napi.napi_env, _: napi.napi_value, context: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+        const self: *Dispatcher = @ptrCast(@alignCast(context));
+        // Clear first, so a post racing with this drain wakes us again.
+        self.wake_pending.store(false, .release);
+        self.runPending(inner_env);
+    }
+
+    /// Runs the nodes queued so far, in posting order. JS thread only. An
+    /// operation that completes on the JS thread itself, instead of posting
+    /// its completion, calls this first: its earlier events are delivered
+    /// before it settles, and none of its nodes stay queued once it is freed.
+    pub fn runPending(self: *Dispatcher, inner_env: napi.napi_env) void {
+        // The list is LIFO; reverse it so nodes run in posting order.
+        var pending = self.head.swap(null, .acquire);
+        var ordered: ?*Node = null;
+        while (pending) |node| {
+            pending = node.next;
+            node.next = ordered;
+            ordered = node;
+        }
+        if (ordered == null or inner_env == null) return;
+
+        var resource: napi.napi_value = null;
+        var scope: napi.napi_callback_scope = null;
+        if (napi.napi_get_reference_value(inner_env, self.resource_ref, &resource) == napi.napi_ok and resource != null) {
+            _ = napi.napi_open_callback_scope(inner_env, resource, self.async_context, &scope);
+        }
+        defer if (scope != null) {
+            _ = napi.napi_close_callback_scope(inner_env, scope);
+        };
+
+        while (ordered) |node| {
+            ordered = node.next;
+            node.next = null;
+
+            var handle_scope: napi.napi_handle_scope = null;
+            const opened = napi.napi_open_handle_scope(inner_env, &handle_scope) == napi.napi_ok;
+            node.run(node, inner_env);
+            reportPendingException(inner_env);
+            if (opened) _ = napi.napi_close_handle_scope(inner_env, handle_scope);
+        }
+    }
+
+    /// A listener that throws leaves its exception pending, which would make
+    /// every later call in the batch fail. Hand it to the runtime as an
+    /// uncaught exception, as it would be for a callback of its own.
+    fn reportPendingException(env: napi.napi_env) void {
+        var pending = false;
+        if (napi.napi_is_exception_pending(env, &pending) != napi.napi_ok or !pending) return;
+
+        var exception: napi.napi_value = null;
+        if (napi.napi_get_and_clear_last_exception(env, &exception) != napi.napi_ok) return;
+        _ = napi.napi_fatal_exception(env, exception);
+    }
+
+    /// Stops the dispatcher when its env is torn down. The memory is freed by
+    /// the thread-safe function finalizer.
+    fn close(self: *Dispatcher, env: napi.napi_env) void {
+        if (self.closed) return;
+        self.closed = true;
+        if (self.async_context != null) {
+            _ = napi.napi_async_destroy(env, self.async_context);
+            self.async_context = null;
+        }
+        if (self.resource_ref != null) {
+            _ = napi.napi_delete_reference(env, self.resource_ref);
+            self.resource_ref = null;
+        }
+        if (self.tsfn_raw != null) {
+            _ = napi.napi_release_threadsafe_function(self.tsfn_raw, napi.napi_tsfn_abort);
+        } else {
+            GlobalAllocator.runtimeAllocator().destroy(self);
+        }
+    }
+
+    fn finalize(_: napi.napi_env, data: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+        const self: *Dispatcher = @ptrCast(@alignCast(data orelse return));
+        GlobalAllocator.runtimeAllocator().destroy(self);
+    }
+
+    fn noop(inner_env: napi.napi_env, _: napi.napi_callback_info) callconv(.c) napi.napi_value {
+        var result: napi.napi_value = null;
+        _ = napi.napi_get_undefined(inner_env, &result);
+        return result;
+    }
+
+    const Handle = struct {
+        dispatcher: *Dispatcher,
+
+        pub fn deinit(self: *Handle, env: napi.napi_env) void {
+            self.dispatcher.close(env);
+        }
+    };
+
+    const Slot = instance_data.Slot(Dispatcher, Handle);
+};
+
+fn check(status: napi.napi_status) !void {
+    if (status != napi.napi_ok) {
+        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+    }
+}
@@ -6,6 +6,7 @@ const String = @import("./value/string.zig").String;
 const NapiValue = @import("./value.zig").NapiValue;
 const NapiError = @import("./wrapper/error.zig");
 const native_wrap = @import("./wrapper/native_wrap.zig");
+const handle_scope = @import("./wrapper/handle_scope.zig");
 const options = @import("./options.zig");
 
 pub const Env = struct {
@@ -80,6 +81,14 @@ pub const Env = struct {
         return NapiValue.from_raw(self.raw, result);
     }
 
+    pub fn openHandleScope(self: Env) !handle_scope.HandleScope {
+        return handle_scope.HandleScope.open(self);
+    }
+
+    pub fn openEscapableHandleScope(self: Env) !handle_scope.EscapableHandleScope {
+        return handle_scope.EscapableHandleScope.open(self);
+    }
+
     pub fn wrap(self: Env, js_object: anytype, payload: anytype) !void {
         return self.wrapWithSizeHint(js_object, payload, 0);
     }
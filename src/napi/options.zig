@@ -40,6 +40,24 @@ pub fn isOhosAddon() bool {
     return !build_options.node_addon;
 }
 
+/// Build-time defaults of the threaded async runtime. Build option modules
+/// created outside the build helpers may not carry them.
+pub const AsyncRuntimeDefaults = struct {
+    workers: u32 = 0,
+    stack_size: u64 = 0,
+    affinity_mask: u64 = 0,
+    warm_start: bool = false,
+};
+
+pub fn asyncRuntimeDefaults() AsyncRuntimeDefaults {
+    var defaults: AsyncRuntimeDefaults = .{};
+    if (@hasDecl(build_options, "async_workers")) defaults.workers = build_options.async_workers;
+    if (@hasDecl(build_options, "async_stack_size")) defaults.stack_size = build_options.async_stack_size;
+    if (@hasDecl(build_options, "async_affinity_mask")) defaults.affinity_mask = build_options.async_affinity_mask;
+    if (@hasDecl(build_options, "async_warm_start")) defaults.warm_start = build_options.async_warm_start;
+    return defaults;
+}
+
 pub fn requireNapiVersion(comptime required: NapiVersion) void {
     const selected = comptime selectedNapiVersion();
     if (!selected.isAtLeast(required)) {
@@ -1,4 +1,5 @@
 const std = @import("std");
+const builtin = @import("builtin");
 const root = @import("root");
 
 pub const AllocatorManager = struct {
@@ -33,7 +34,19 @@ pub fn defaultAllocator() std.mem.Allocator {
         return allocator;
     }
 
-    return std.heap.page_allocator;
+    return builtinAllocator();
+}
+
+/// Allocator used when the addon root does not provide `napi_allocator`.
+/// `smp_allocator` keeps size-classed free lists per thread and only maps pages
+/// for large blocks, so short-lived strings, slices and operation records do not
+/// each cost a full page and an mmap/munmap pair. Single-threaded and wasm
+/// builds keep the page allocator because `smp_allocator` requires threads.
+fn builtinAllocator() std.mem.Allocator {
+    if (builtin.single_threaded or builtin.cpu.arch == .wasm32) {
+        return std.heap.page_allocator;
+    }
+    return std.heap.smp_allocator;
 }
 
 pub var global_manager = AllocatorManager.init(defaultAllocator());
@@ -48,3 +61,124 @@ pub fn globalAllocator() std.mem.Allocator {
 pub fn runtimeAllocator() std.mem.Allocator {
     return runtime_manager.get();
 }
+
+/// Bytes the per-thread call arena keeps between calls. Larger bursts are
+/// returned to the backing allocator when the outermost call scope ends.
+pub const call_arena_retain_limit: usize = 64 * 1024;
+
+threadlocal var call_arena: ?std.heap.ArenaAllocator = null;
+threadlocal var call_arena_depth: usize = 0;
+threadlocal var call_arena_converting: bool = false;
+
+fn sameAllocator(a: std.mem.Allocator, b: std.mem.Allocator) bool {
+    return a.ptr == b.ptr and a.vtable == b.vtable;
+}
+
+/// Scope of one exported call while its JavaScript arguments are converted.
+/// Arena scopes route conversions made between `begin` and `endConversion`
+/// into a per-thread bump arena that is reset once the outermost arena scope
+/// ends, so calls re-entering from JavaScript keep the outer call's arguments
+/// alive. Owned scopes convert with the operation allocator because the
+/// callee keeps the values (class fields, async descriptors).
+pub const CallScope = struct {
+    active: bool = false,
+    uses_arena: bool = false,
+    previous_converting: bool = false,
+
+    pub fn begin() CallScope {
+        const backing = globalAllocator();
+        if (call_arena_depth == 0) {
+            if (call_arena) |*arena| {
+                if (!sameAllocator(arena.child_allocator, backing)) {
+                    arena.deinit();
+                    call_arena = null;
+                }
+            }
+        }
+        if (call_arena == null) {
+            call_arena = std.heap.ArenaAllocator.init(backing);
+        }
+
+        call_arena_depth += 1;
+        const scope = CallScope{
+            .active = true,
+            .uses_arena = true,
+            .previous_converting = call_arena_converting,
+        };
+        call_arena_converting = true;
+        return scope;
+    }
+
+    pub fn beginOwned() CallScope {
+        const scope = CallScope{
+            .active = true,
+            .previous_converting = call_arena_converting,
+        };
+        call_arena_converting = false;
+        return scope;
+    }
+
+    /// Stop routing conversions into the arena while the user function runs.
+    /// Memory converted so far stays valid until `end`.
+    pub fn endConversion(self: *const CallScope) void {
+        if (!self.active) return;
+        call_arena_converting = false;
+    }
+
+    pub fn end(self: *CallScope) void {
+        if (!self.active) return;
+        self.active = false;
+        call_arena_converting = self.previous_converting;
+        if (!self.uses_arena) return;
+
+        call_arena_depth -= 1;
+        if (call_arena_depth != 0) return;
+
+        if (call_arena) |*arena| {
+            // Scoped operation allocators (for example leak trackers installed via
+            // `setOperationAllocator`) must see every transient byte returned.
+            if (sameAllocator(arena.child_allocator, defaultAllocator())) {
+                _ = arena.reset(.{ .retain_with_limit = call_arena_retain_limit });
+            } else {
+                arena.deinit();
+                call_arena = null;
+            }
+        }
+    }
+};
+
+/// Allocator for values converted from JavaScript. Inside a call scope this is
+/// the per-call arena; otherwise the converted value is owned by the caller and
+/// comes from the operation allocator.
+pub fn conversionAllocator() std.mem.Allocator {
+    if (call_arena_converting) {
+        if (call_arena) |*arena| {
+            return arena.allocator();
+        }
+    }
+    return globalAllocator();
+}
+
+test "CallScope routes only argument conversion into the call arena" {
+    const global = globalAllocator();
+    try std.testing.expect(sameAllocator(conversionAllocator(), global));
+
+    var outer = CallScope.begin();
+    try std.testing.expect(!sameAllocator(conversionAllocator(), global));
+    _ = try conversionAllocator().alloc(u8, 32);
+    outer.endConversion();
+    try std.testing.expect(sameAllocator(conversionAllocator(), global));
+
+    var owned = CallScope.beginOwned();
+    try std.testing.expect(sameAllocator(conversionAllocator(), global));
+    owned.end();
+
+    var inner = CallScope.begin();
+    try std.testing.expect(!sameAllocator(conversionAllocator(), global));
+    inner.end();
+    try std.testing.expectEqual(@as(usize, 1), call_arena_depth);
+
+    outer.end();
+    try std.testing.expectEqual(@as(usize, 0), call_arena_depth);
+    try std.testing.expect(sameAllocator(conversionAllocator(), global));
+}
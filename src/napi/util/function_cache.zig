@@ -0,0 +1,153 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const GlobalAllocator = @import("./allocator.zig");
+const options = @import("../options.zig");
+
+const function_cache_magic: u64 = 0x5a_4e_41_50_49_46_4e_43;
+
+/// Marks functions whose wrap is a `FunctionCache`. The tag is checked
+/// before `napi_unwrap`, so a pointer wrapped by other native code is never
+/// read.
+const function_cache_tag = napi.napi_type_tag{
+    .lower = function_cache_magic,
+    .upper = 0x66_75_6e_63_61_63_68_65,
+};
+
+/// Type tags need Node-API v8. Without them a wrap cannot be identified
+/// safely, so nothing is cached and every conversion creates a new value.
+fn cachesFunctions() bool {
+    return options.isOhosAddon() or options.selectedNapiVersion().isAtLeast(.v8);
+}
+
+/// Native values cached on a JS function object, such as the thread-safe
+/// function created for it. The cache is attached with `napi_wrap`, so it
+/// lives exactly as long as the function. Entries are keyed by the address
+/// of a per-type marker, so one function can back several wrapper types.
+///
+/// Functions already wrapped or type-tagged by someone else are not cached.
+/// All calls run on the JS thread of the env.
+pub const FunctionCache = struct {
+    magic: u64 = function_cache_magic,
+    entries: std.ArrayList(Entry) = .empty,
+
+    pub const Entry = struct {
+        key: *const anyopaque,
+        value: *anyopaque,
+        /// Tells the value that the cache is gone.
+        detach: *const fn (*anyopaque) void,
+    };
+
+    fn find(self: *FunctionCache, key: *const anyopaque) ?usize {
+        for (self.entries.items, 0..) |cached, i| {
+            if (cached.key == key) return i;
+        }
+        return null;
+    }
+
+    /// Drops the entry holding `value`, if any.
+    pub fn forget(self: *FunctionCache, value: *anyopaque) void {
+        for (self.entries.items, 0..) |cached, i| {
+            if (cached.value == value) {
+                _ = self.entries.swapRemove(i);
+                return;
+            }
+        }
+    }
+};
+
+fn existing(env: napi.napi_env, function: napi.napi_value) ?*FunctionCache {
+    var tagged = false;
+    if (napi.napi_check_object_type_tag(env, function, &function_cache_tag, &tagged) != napi.napi_ok or !tagged) {
+        return null;
+    }
+
+    var data: ?*anyopaque = null;
+    if (napi.napi_unwrap(env, function, &data) != napi.napi_ok) return null;
+    const ptr = data orelse return null;
+    if (@intFromPtr(ptr) % @alignOf(FunctionCache) != 0) return null;
+
+    const cache: *FunctionCache = @ptrCast(@alignCast(ptr));
+    if (cache.magic != function_cache_magic) return null;
+    return cache;
+}
+
+/// Returns the value cached on `function` under `key`.
+pub fn lookup(env: napi.napi_env, function: napi.napi_value, key: *const anyopaque) ?*anyopaque {
+    if (!cachesFunctions()) return null;
+    const cache = existing(env, function) orelse return null;
+    const index = cache.find(key) orelse return null;
+    return cache.entries.items[index].value;
+}
+
+/// Caches `value` on `function` under `key`, replacing any previous entry.
+/// Returns the cache so the value can `forget` itself later, or null when
+/// the function cannot carry a cache.
+pub fn remember(
+    env: napi.napi_env,
+    function: napi.napi_value,
+    key: *const anyopaque,
+    value: *anyopaque,
+    detach: *const fn (*anyopaque) void,
+) ?*FunctionCache {
+    if (!cachesFunctions()) return null;
+
+    const allocator = GlobalAllocator.runtimeAllocator();
+    const cache = existing(env, function) orelse blk: {
+        const created = allocator.create(FunctionCache) catch return null;
+        created.* = .{};
+        if (napi.napi_wrap(env, function, created, finalizeCache, null, null) != napi.napi_ok) {
+            allocator.destroy(created);
+            return null;
+        }
+        // Tag only after the wrap is ours, so a tagged function always
+        // carries a cache.
+        if (napi.napi_type_tag_object(env, function, &function_cache_tag) != napi.napi_ok) {
+            _ = napi.napi_remove_wrap(env, function, null);
+            allocator.destroy(created);
+            return null;
+        }
+        break :blk created;
+    };
+
+    if (cache.find(key)) |index| {
+        const previous = cache.entries.items[index];
+        previous.detach(previous.value);
+        cache.entries.items[index] = .{ .key = key, .value = value, .detach = detach };
+        return cache;
+    }
+
+    cache.entries.append(allocator, .{ .key = key, .value = value, .detach = detach }) catch return null;
+    return cache;
+}
+
+fn finalizeCache(_: napi.napi_env, data: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+    const cache: *FunctionCache = @ptrCast(@alignCast(data orelse return));
+    for (cache.entries.items) |cached| {
+        cached.detach(cached.value);
+    }
+    cache.entries.deinit(GlobalAllocator.runtimeAllocator());
+    cache.magic = 0;
+    GlobalAllocator.runtimeAllocator().destroy(cache);
+}
+
+test "FunctionCache forgets entries by value" {
+    const Detach = struct {
+        fn detach(_: *anyopaque) void {}
+    };
+    const Keys = struct {
+        var a: u8 = 0;
+        var b: u8 = 0;
+    };
+    var value_a: u32 = 1;
+    var value_b: u32 = 2;
+
+    var cache = FunctionCache{};
+    defer cache.entries.deinit(std.testing.allocator);
+    try cache.entries.append(std.testing.allocator, .{ .key = &Keys.a, .value = &value_a, .detach = Detach.detach });
+    try cache.entries.append(std.testing.allocator, .{ .key = &Keys.b, .value = &value_b, .detach = Detach.detach });
+
+    try std.testing.expectEqual(@as(?usize, 1), cache.find(&Keys.b));
+    cache.forget(&value_a);
+    try std.testing.expectEqual(@as(?usize, null), cache.find(&Keys.a));
+    try std.testing.expectEqual(@as(?usize, 0), cache.find(&Keys.b));
+}
@@ -84,6 +84,13 @@ pub fn isThreadSafeFunction(comptime T: type) bool {
     return false;
 }
 
+pub fn isBatchedThreadSafeFunction(comptime T: type) bool {
+    if (@typeInfo(T) != .@"struct") {
+        return false;
+    }
+    return @hasDecl(T, "is_napi_batched_tsfn");
+}
+
 pub fn isAsyncDescriptor(comptime T: type) bool {
     switch (@typeInfo(T)) {
         .@"struct", .@"enum", .@"union", .@"opaque" => {},
@@ -116,6 +123,22 @@ pub fn isExternal(comptime T: type) bool {
     return @hasDecl(T, "is_napi_external");
 }
 
+pub fn isSmallString(comptime T: type) bool {
+    switch (@typeInfo(T)) {
+        .@"struct", .@"enum", .@"union", .@"opaque" => {},
+        else => return false,
+    }
+    return @hasDecl(T, "is_napi_small_string");
+}
+
+pub fn isBorrowed(comptime T: type) bool {
+    switch (@typeInfo(T)) {
+        .@"struct", .@"enum", .@"union", .@"opaque" => {},
+        else => return false,
+    }
+    return @hasDecl(T, "is_napi_borrowed");
+}
+
 pub fn isDts(comptime T: type) bool {
     switch (@typeInfo(T)) {
         .@"struct", .@"enum", .@"union", .@"opaque" => {},
@@ -137,6 +160,24 @@ pub fn isArrayList(comptime T: type) bool {
     return false;
 }
 
+/// True when values of `T` own no memory, so releasing them needs no
+/// allocator: numbers, bools, enums and arrays, optionals or structs of them.
+pub fn isPlainData(comptime T: type) bool {
+    return switch (@typeInfo(T)) {
+        .int, .float, .bool, .@"enum", .void => true,
+        .array => |array| isPlainData(array.child),
+        .optional => |optional| isPlainData(optional.child),
+        .@"struct" => |info| blk: {
+            if (@hasDecl(T, "deinit")) break :blk false;
+            for (info.fields) |field| {
+                if (!isPlainData(field.type)) break :blk false;
+            }
+            break :blk true;
+        },
+        else => false,
+    };
+}
+
 pub fn getArrayListElementType(comptime T: type) type {
     const info = @typeInfo(T);
     if (info != .@"struct") {
@@ -0,0 +1,275 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const NapiError = @import("../wrapper/error.zig");
+const GlobalAllocator = @import("./allocator.zig");
+const options = @import("../options.zig");
+
+/// Per-env registry for library state such as class constructors, interned
+/// keys and cached constants.
+///
+/// On Node-API v6 and newer the registry is attached with
+/// `napi_set_instance_data`, so every worker env gets its own copy and the
+/// registry is torn down with the env. Addons built on zig-napi must not call
+/// `napi_set_instance_data` themselves. Older versions keep the registries
+/// of a thread's envs in a thread-local list, released by an env cleanup
+/// hook.
+///
+/// Entries are addressed by a process-wide slot index assigned on first use,
+/// and the registry of the env last seen on the current thread is cached, so
+/// a lookup is a thread-local compare and an array index.
+pub const Registry = struct {
+    env: napi.napi_env,
+    entries: std.ArrayList(?Entry) = .empty,
+    /// Next registry of the same thread, below Node-API v6.
+    next: ?*Registry = null,
+
+    const Entry = struct {
+        ptr: *anyopaque,
+        destroy: *const fn (napi.napi_env, *anyopaque) void,
+    };
+
+    fn entry(self: *Registry, index: u32) ?*anyopaque {
+        if (index >= self.entries.items.len) return null;
+        const slot = self.entries.items[index] orelse return null;
+        return slot.ptr;
+    }
+
+    fn put(self: *Registry, index: u32, value: Entry) !void {
+        const allocator = GlobalAllocator.runtimeAllocator();
+        if (index >= self.entries.items.len) {
+            try self.entries.appendNTimes(allocator, null, index + 1 - self.entries.items.len);
+        }
+        std.debug.assert(self.entries.items[index] == null);
+        self.entries.items[index] = value;
+    }
+
+    fn destroy(self: *Registry) void {
+        var i = self.entries.items.len;
+        while (i > 0) {
+            i -= 1;
+            if (self.entries.items[i]) |slot| {
+                self.entries.items[i] = null;
+                slot.destroy(self.env, slot.ptr);
+            }
+        }
+        self.entries.deinit(GlobalAllocator.runtimeAllocator());
+
+        if (comptime !usesInstanceData()) unlinkThreadRegistry(self);
+        teardown_epoch +%= 1;
+        if (cached_registry == self) {
+            cached_env = null;
+            cached_registry = null;
+        }
+        GlobalAllocator.runtimeAllocator().destroy(self);
+    }
+};
+
+threadlocal var cached_env: napi.napi_env = null;
+threadlocal var cached_registry: ?*Registry = null;
+/// Registries of this thread's envs when instance data is unavailable.
+threadlocal var thread_registries: ?*Registry = null;
+/// Bumped whenever a registry of this thread is torn down, so memos keyed by
+/// env do not outlive the env.
+threadlocal var teardown_epoch: u32 = 0;
+
+fn unlinkThreadRegistry(registry: *Registry) void {
+    var link = &thread_registries;
+    while (link.*) |current| : (link = &current.next) {
+        if (current == registry) {
+            link.* = current.next;
+            return;
+        }
+    }
+}
+
+var next_slot_index = std.atomic.Value(u32).init(0);
+const unassigned_slot = std.math.maxInt(u32);
+
+fn usesInstanceData() bool {
+    return options.selectedNapiVersion().isAtLeast(.v6);
+}
+
+fn canRegisterCleanup() bool {
+    return options.selectedNapiVersion().isAtLeast(.v3);
+}
+
+/// Returns the registry of `env`, or null when none was created yet.
+pub fn registryFor(env: napi.napi_env) ?*Registry {
+    if (env == null) return null;
+    if (cached_env == env) return cached_registry;
+
+    if (comptime usesInstanceData()) {
+        var data: ?*anyopaque = null;
+        if (napi.napi_get_instance_data(env, &data) != napi.napi_ok) return null;
+        const registry: *Registry = @ptrCast(@alignCast(data orelse return null));
+        cached_env = env;
+        cached_registry = registry;
+        return registry;
+    }
+
+    var current = thread_registries;
+    while (current) |registry| : (current = registry.next) {
+        if (registry.env == env) {
+            cached_env = env;
+            cached_registry = registry;
+            return registry;
+        }
+    }
+    return null;
+}
+
+/// Returns the registry of `env`, creating it on first use.
+pub fn ensureRegistry(env: napi.napi_env) !*Registry {
+    if (registryFor(env)) |registry| return registry;
+
+    const allocator = GlobalAllocator.runtimeAllocator();
+    const registry = allocator.create(Registry) catch @panic("OOM");
+    registry.* = .{ .env = env };
+
+    const status = if (comptime usesInstanceData())
+        napi.napi_set_instance_data(env, registry, finalizeRegistry, null)
+    else if (comptime canRegisterCleanup())
+        napi.napi_add_env_cleanup_hook(env, cleanupRegistry, registry)
+    else
+        napi.napi_ok;
+    if (status != napi.napi_ok) {
+        allocator.destroy(registry);
+        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+    }
+
+    if (comptime !usesInstanceData()) {
+        registry.next = thread_registries;
+        thread_registries = registry;
+    }
+    cached_env = env;
+    cached_registry = registry;
+    return registry;
+}
+
+fn finalizeRegistry(_: napi.napi_env, data: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+    const registry: *Registry = @ptrCast(@alignCast(data orelse return));
+    registry.destroy();
+}
+
+fn cleanupRegistry(data: ?*anyopaque) callconv(.c) void {
+    const registry: *Registry = @ptrCast(@alignCast(data orelse return));
+    registry.destroy();
+}
+
+/// Typed registry slot. `Tag` only makes the slot unique; `Value` is stored
+/// in runtime-allocated memory owned by the registry. When the env is torn
+/// down, `Value.deinit(*Value, napi_env)` runs if declared, then the memory
+/// is released.
+pub fn Slot(comptime Tag: type, comptime Value: type) type {
+    if (@sizeOf(Value) == 0) {
+        @compileError("instance data slots need a non-zero-sized value, got: " ++ @typeName(Value));
+    }
+
+    return struct {
+        var index = std.atomic.Value(u32).init(unassigned_slot);
+
+        pub const tag = Tag;
+
+        fn slotIndex() u32 {
+            const current = index.load(.acquire);
+            if (current != unassigned_slot) return current;
+
+            const assigned = next_slot_index.fetchAdd(1, .monotonic);
+            return index.cmpxchgStrong(unassigned_slot, assigned, .acq_rel, .acquire) orelse assigned;
+        }
+
+        pub fn get(env: napi.napi_env) ?*Value {
+            const registry = registryFor(env) orelse return null;
+            const ptr = registry.entry(slotIndex()) orelse return null;
+            return @ptrCast(@alignCast(ptr));
+        }
+
+        /// Stores `value` for `env`. The slot must be empty.
+        pub fn put(env: napi.napi_env, value: Value) !*Value {
+            const registry = try ensureRegistry(env);
+            const allocator = GlobalAllocator.runtimeAllocator();
+            const stored = allocator.create(Value) catch @panic("OOM");
+            stored.* = value;
+            registry.put(slotIndex(), .{ .ptr = stored, .destroy = destroyValue }) catch {
+                allocator.destroy(stored);
+                @panic("OOM");
+            };
+            return stored;
+        }
+
+        fn destroyValue(env: napi.napi_env, ptr: *anyopaque) void {
+            const stored: *Value = @ptrCast(@alignCast(ptr));
+            if (comptime @typeInfo(Value) == .@"struct" and @hasDecl(Value, "deinit")) {
+                stored.deinit(env);
+            }
+            GlobalAllocator.runtimeAllocator().destroy(stored);
+        }
+    };
+}
+
+/// Registry slot holding one JS value through a strong reference.
+///
+/// Values that the engine cannot reference (primitives before Node-API v10
+/// on some runtimes) are not cached; `get` keeps returning null and callers
+/// recreate the value. The first failed reference is remembered per thread,
+/// so later calls on that env skip both the reference and the registry.
+pub fn RefSlot(comptime Tag: type) type {
+    return struct {
+        threadlocal var uncacheable_env: napi.napi_env = null;
+        threadlocal var uncacheable_epoch: u32 = 0;
+
+        fn isUncacheable(env: napi.napi_env) bool {
+            return uncacheable_env == env and uncacheable_epoch == teardown_epoch;
+        }
+
+        fn markUncacheable(env: napi.napi_env) void {
+            uncacheable_env = env;
+            uncacheable_epoch = teardown_epoch;
+        }
+
+        const Holder = struct {
+            ref: napi.napi_ref,
+
+            pub fn deinit(self: *Holder, env: napi.napi_env) void {
+                _ = napi.napi_delete_reference(env, self.ref);
+            }
+        };
+        const Inner = Slot(Tag, Holder);
+
+        pub const tag = Tag;
+
+        pub fn get(env: napi.napi_env) ?napi.napi_value {
+            if (isUncacheable(env)) return null;
+            const holder = Inner.get(env) orelse return null;
+            var raw: napi.napi_value = undefined;
+            if (napi.napi_get_reference_value(env, holder.ref, &raw) != napi.napi_ok or raw == null) {
+                return null;
+            }
+            return raw;
+        }
+
+        /// Caches `raw` for `env` unless a value is already cached. Failures
+        /// leave the slot empty.
+        pub fn remember(env: napi.napi_env, raw: napi.napi_value) void {
+            if (isUncacheable(env) or Inner.get(env) != null) return;
+
+            var ref: napi.napi_ref = null;
+            if (napi.napi_create_reference(env, raw, 1, &ref) != napi.napi_ok) {
+                markUncacheable(env);
+                return;
+            }
+            _ = Inner.put(env, .{ .ref = ref }) catch {
+                _ = napi.napi_delete_reference(env, ref);
+                markUncacheable(env);
+            };
+        }
+    };
+}
+
+test "Slot types are unique per tag" {
+    const A = Slot(struct {}, u32);
+    const B = Slot(struct {}, u32);
+    try std.testing.expect(A != B);
+    try std.testing.expect(A.slotIndex() != B.slotIndex());
+    try std.testing.expect(A.slotIndex() == A.slotIndex());
+}
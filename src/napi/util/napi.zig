@@ -13,6 +13,8 @@ const DataView = @import("../wrapper/dataview.zig").DataView;
 const AbortSignal = @import("../abort_signal.zig").AbortSignal;
 const GlobalAllocator = @import("./allocator.zig");
 const options = @import("../options.zig");
+const property_key = @import("./property_key.zig");
+const instance_data = @import("./instance_data.zig");
 
 fn napiTypeOf(env: napi.napi_env, raw: napi.napi_value) napi.napi_valuetype {
     var value_type: napi.napi_valuetype = undefined;
@@ -44,8 +46,8 @@ fn isTypedArrayValue(env: napi.napi_env, raw: napi.napi_value) bool {
     return result;
 }
 
-fn typedArrayValueMatchesType(env: napi.napi_env, raw: napi.napi_value, comptime T: type) bool {
-    if (!isTypedArrayValue(env, raw)) return false;
+/// Assumes `raw` is already known to be a typed array.
+fn typedArrayKindMatches(env: napi.napi_env, raw: napi.napi_value, comptime T: type) bool {
     if (!@hasDecl(T, "raw_typedarray_type")) return true;
 
     var actual_type: napi.napi_typedarray_type = undefined;
@@ -77,17 +79,6 @@ fn isPromiseValue(env: napi.napi_env, raw: napi.napi_value) bool {
     return result;
 }
 
-fn isPlainObjectValue(env: napi.napi_env, raw: napi.napi_value) bool {
-    if (napiTypeOf(env, raw) != napi.napi_object) return false;
-    if (isArrayValue(env, raw)) return false;
-    if (isBufferValue(env, raw)) return false;
-    if (isArrayBufferValue(env, raw)) return false;
-    if (isTypedArrayValue(env, raw)) return false;
-    if (isDataViewValue(env, raw)) return false;
-    if (isPromiseValue(env, raw)) return false;
-    return true;
-}
-
 fn unionDefaultValue(comptime T: type) T {
     const union_info = @typeInfo(T).@"union";
     if (union_info.fields.len == 0) {
@@ -102,13 +93,30 @@ fn isStringEnum(comptime T: type) bool {
     return @hasDecl(T, "napi_string_enum") and @TypeOf(@field(T, "napi_string_enum")) == bool and @field(T, "napi_string_enum");
 }
 
+fn maxEnumNameLen(comptime T: type) usize {
+    var max: usize = 0;
+    for (@typeInfo(T).@"enum".fields) |field| {
+        max = @max(max, field.name.len);
+    }
+    return max;
+}
+
+/// Decodes into a stack buffer sized for the longest tag name, then compares
+/// only the tags whose length matches. Four spare bytes make a full read
+/// distinguishable from a read cut short before a multi-byte character.
 fn enumFromString(env: napi.napi_env, raw: napi.napi_value, comptime T: type) T {
     const enum_info = @typeInfo(T).@"enum";
-    const value = NapiValue.String.from_napi_value(env, raw, []const u8);
+    const max_len = comptime maxEnumNameLen(T);
 
-    inline for (enum_info.fields) |field| {
-        if (std.mem.eql(u8, value, field.name)) {
-            return @field(T, field.name);
+    var buf: [max_len + 5]u8 = undefined;
+    var len: usize = 0;
+    const status = napi.napi_get_value_string_utf8(env, raw, &buf, buf.len, &len);
+    if (status == napi.napi_ok and len <= max_len) {
+        const value = buf[0..len];
+        inline for (enum_info.fields) |field| {
+            if (value.len == field.name.len and std.mem.eql(u8, value, field.name)) {
+                return @field(T, field.name);
+            }
         }
     }
 
@@ -116,6 +124,13 @@ fn enumFromString(env: napi.napi_env, raw: napi.napi_value, comptime T: type) T
     return @field(T, enum_info.fields[0].name);
 }
 
+/// Tag strings of string enums are created once per env and reused.
+fn stringEnumTag(env: napi.napi_env, value: anytype) !napi.napi_value {
+    switch (value) {
+        inline else => |tag| return property_key.PropertyKey(@tagName(tag)).get(env),
+    }
+}
+
 fn enumFromNumber(env: napi.napi_env, raw: napi.napi_value, comptime T: type) T {
     const enum_info = @typeInfo(T).@"enum";
     const Tag = enum_info.tag_type;
@@ -131,104 +146,310 @@ fn enumFromNumber(env: napi.napi_env, raw: napi.napi_value, comptime T: type) T
     return @field(T, enum_info.fields[0].name);
 }
 
+/// Enum objects are built once per env and reused for later exports.
 fn enumTypeToObject(env: napi.napi_env, comptime E: type) !napi.napi_value {
-    var raw: napi.napi_value = undefined;
-    const status = napi.napi_create_object(env, &raw);
-    if (status != napi.napi_ok) {
-        return NapiError.Error.fromStatus(NapiError.Status.New(status));
-    }
+    const Slot = instance_data.RefSlot(struct {
+        const Enum = E;
+    });
+    if (Slot.get(env)) |raw| return raw;
+
+    const fields = @typeInfo(E).@"enum".fields;
+    const names = comptime blk: {
+        var result: [fields.len][:0]const u8 = undefined;
+        for (fields, 0..) |field, i| {
+            result[i] = field.name;
+        }
+        break :blk result;
+    };
 
-    const object = NapiValue.Object.from_raw(env, raw);
-    inline for (@typeInfo(E).@"enum".fields) |field| {
+    var values: [fields.len]napi.napi_value = undefined;
+    inline for (fields, 0..) |field, i| {
         if (comptime isStringEnum(E)) {
-            try object.Set(field.name, field.name);
+            values[i] = try property_key.PropertyKey(field.name).get(env);
         } else {
             const Tag = @typeInfo(E).@"enum".tag_type;
-            try object.Set(field.name, @as(Tag, @intCast(field.value)));
+            values[i] = try Napi.to_napi_value(env, @as(Tag, @intCast(field.value)), null);
         }
     }
-    return raw;
+
+    const object = try NapiValue.Object.NewWithNamedValues(Env.from_raw(env), &names, &values);
+    Slot.remember(env, object.raw);
+    return object.raw;
+}
+
+/// Lazily classified JS value used while picking a union or optional
+/// variant. `napi_typeof` and every `napi_is_*` query run at most once per
+/// value, and the object-only queries are skipped for primitives.
+const ValueClass = struct {
+    env: napi.napi_env,
+    raw: napi.napi_value,
+    value_type: ?napi.napi_valuetype = null,
+    is_array: ?bool = null,
+    is_buffer: ?bool = null,
+    is_arraybuffer: ?bool = null,
+    is_typedarray: ?bool = null,
+    is_dataview: ?bool = null,
+    is_promise: ?bool = null,
+
+    fn init(env: napi.napi_env, raw: napi.napi_value) ValueClass {
+        return .{ .env = env, .raw = raw };
+    }
+
+    fn typeOf(self: *ValueClass) napi.napi_valuetype {
+        if (self.value_type) |value_type| return value_type;
+        const value_type = napiTypeOf(self.env, self.raw);
+        self.value_type = value_type;
+        return value_type;
+    }
+
+    fn typeBit(self: *ValueClass) u16 {
+        return valueTypeBit(self.typeOf());
+    }
+
+    fn cached(self: *ValueClass, slot: *?bool, comptime query: fn (napi.napi_env, napi.napi_value) bool) bool {
+        if (slot.*) |result| return result;
+        const result = self.typeOf() == napi.napi_object and query(self.env, self.raw);
+        slot.* = result;
+        return result;
+    }
+
+    fn isArray(self: *ValueClass) bool {
+        return self.cached(&self.is_array, isArrayValue);
+    }
+
+    fn isBuffer(self: *ValueClass) bool {
+        return self.cached(&self.is_buffer, isBufferValue);
+    }
+
+    fn isArrayBuffer(self: *ValueClass) bool {
+        return self.cached(&self.is_arraybuffer, isArrayBufferValue);
+    }
+
+    fn isTypedArray(self: *ValueClass) bool {
+        return self.cached(&self.is_typedarray, isTypedArrayValue);
+    }
+
+    fn isDataView(self: *ValueClass) bool {
+        return self.cached(&self.is_dataview, isDataViewValue);
+    }
+
+    fn isPromise(self: *ValueClass) bool {
+        return self.cached(&self.is_promise, isPromiseValue);
+    }
+
+    fn isPlainObject(self: *ValueClass) bool {
+        if (self.typeOf() != napi.napi_object) return false;
+        return !self.isArray() and !self.isBuffer() and !self.isArrayBuffer() and
+            !self.isTypedArray() and !self.isDataView() and !self.isPromise();
+    }
+};
+
+fn valueTypeBit(value_type: napi.napi_valuetype) u16 {
+    if (value_type < 0 or value_type > 15) return 0;
+    return @as(u16, 1) << @intCast(value_type);
+}
+
+const any_value_type: u16 = std.math.maxInt(u16);
+
+/// Comptime mask of the `napi_typeof` results a Zig type can be converted
+/// from. Union dispatch checks it before running the full match, so variants
+/// of the wrong primitive kind cost no engine calls.
+fn acceptedValueTypes(comptime T: type) u16 {
+    if (comptime helper.isDts(T)) {
+        return acceptedValueTypes(T.wrapped_type);
+    }
+
+    switch (T) {
+        NapiValue.Number => return valueTypeBit(napi.napi_number),
+        NapiValue.String => return valueTypeBit(napi.napi_string),
+        NapiValue.NapiValue => return any_value_type,
+        NapiValue.BigInt => return valueTypeBit(napi.napi_bigint),
+        NapiValue.Bool => return valueTypeBit(napi.napi_boolean),
+        NapiValue.Object, NapiValue.Promise, NapiValue.Array, Buffer, ArrayBuffer, DataView => return valueTypeBit(napi.napi_object),
+        NapiValue.Undefined => return valueTypeBit(napi.napi_undefined),
+        NapiValue.Null => return valueTypeBit(napi.napi_null),
+        else => {},
+    }
+
+    if (comptime helper.stringLike(T) != .Unknown) {
+        return valueTypeBit(napi.napi_string);
+    }
+
+    const infos = @typeInfo(T);
+    return switch (infos) {
+        .float, .int, .comptime_int, .comptime_float => valueTypeBit(napi.napi_number),
+        .bool => valueTypeBit(napi.napi_boolean),
+        .array, .pointer => valueTypeBit(napi.napi_object),
+        .optional => valueTypeBit(napi.napi_null) | valueTypeBit(napi.napi_undefined) | acceptedValueTypes(infos.optional.child),
+        .@"struct" => blk: {
+            if (helper.isSmallString(T)) break :blk valueTypeBit(napi.napi_string);
+            if (helper.isNapiFunction(T)) break :blk valueTypeBit(napi.napi_function);
+            if (helper.isReference(T) or helper.isExternal(T)) break :blk any_value_type;
+            break :blk valueTypeBit(napi.napi_object);
+        },
+        .@"union" => any_value_type,
+        .@"enum" => if (isStringEnum(T)) valueTypeBit(napi.napi_string) else valueTypeBit(napi.napi_number),
+        else => 0,
+    };
 }
 
 fn valueMatchesType(env: napi.napi_env, raw: napi.napi_value, comptime T: type) bool {
+    var class_info = ValueClass.init(env, raw);
+    return valueMatchesClass(&class_info, T);
+}
+
+fn valueMatchesClass(value: *ValueClass, comptime T: type) bool {
     if (comptime helper.isDts(T)) {
-        return valueMatchesType(env, raw, T.wrapped_type);
+        return valueMatchesClass(value, T.wrapped_type);
     }
 
+    const env = value.env;
+    const raw = value.raw;
+
     switch (T) {
-        NapiValue.Number => return napiTypeOf(env, raw) == napi.napi_number,
-        NapiValue.String => return napiTypeOf(env, raw) == napi.napi_string,
+        NapiValue.Number => return value.typeOf() == napi.napi_number,
+        NapiValue.String => return value.typeOf() == napi.napi_string,
         NapiValue.NapiValue => return true,
         NapiValue.BigInt => {
             comptime options.requireNapiVersion(.v6);
-            return napiTypeOf(env, raw) == napi.napi_bigint;
+            return value.typeOf() == napi.napi_bigint;
         },
-        NapiValue.Bool => return napiTypeOf(env, raw) == napi.napi_boolean,
-        NapiValue.Object => return isPlainObjectValue(env, raw),
-        NapiValue.Promise => return isPromiseValue(env, raw),
-        NapiValue.Array => return isArrayValue(env, raw) or isTypedArrayValue(env, raw),
-        NapiValue.Undefined => return napiTypeOf(env, raw) == napi.napi_undefined,
-        NapiValue.Null => return napiTypeOf(env, raw) == napi.napi_null,
-        Buffer => return isBufferValue(env, raw),
-        ArrayBuffer => return isArrayBufferValue(env, raw),
-        DataView => return isDataViewValue(env, raw),
+        NapiValue.Bool => return value.typeOf() == napi.napi_boolean,
+        NapiValue.Object => return value.isPlainObject(),
+        NapiValue.Promise => return value.isPromise(),
+        NapiValue.Array => return value.isArray() or value.isTypedArray(),
+        NapiValue.Undefined => return value.typeOf() == napi.napi_undefined,
+        NapiValue.Null => return value.typeOf() == napi.napi_null,
+        Buffer => return value.isBuffer(),
+        ArrayBuffer => return value.isArrayBuffer(),
+        DataView => return value.isDataView(),
         else => {},
     }
 
     const string_mode = comptime helper.stringLike(T);
     if (string_mode != .Unknown) {
-        return napiTypeOf(env, raw) == napi.napi_string;
+        return value.typeOf() == napi.napi_string;
     }
 
     const infos = @typeInfo(T);
     return switch (infos) {
-        .float, .int, .comptime_int, .comptime_float => napiTypeOf(env, raw) == napi.napi_number,
-        .bool => napiTypeOf(env, raw) == napi.napi_boolean,
-        .array => isArrayValue(env, raw) or isTypedArrayValue(env, raw),
-        .pointer => helper.isSlice(T) and (isArrayValue(env, raw) or isTypedArrayValue(env, raw)),
+        .float, .int, .comptime_int, .comptime_float => value.typeOf() == napi.napi_number,
+        .bool => value.typeOf() == napi.napi_boolean,
+        .array => value.isArray() or value.isTypedArray(),
+        .pointer => helper.isSlice(T) and (value.isArray() or value.isTypedArray()),
         .optional => blk: {
-            const value_type = napiTypeOf(env, raw);
+            const value_type = value.typeOf();
             if (value_type == napi.napi_null or value_type == napi.napi_undefined) {
                 break :blk true;
             }
-            break :blk valueMatchesType(env, raw, infos.optional.child);
+            break :blk valueMatchesClass(value, infos.optional.child);
         },
         .@"struct" => blk: {
-            if (comptime helper.isAbortSignal(T)) break :blk napiTypeOf(env, raw) == napi.napi_object;
-            if (comptime helper.isNapiFunction(T)) break :blk napiTypeOf(env, raw) == napi.napi_function;
-            if (comptime helper.isTypedArray(T)) break :blk typedArrayValueMatchesType(env, raw, T);
-            if (comptime helper.isDataView(T)) break :blk isDataViewValue(env, raw);
+            if (comptime helper.isAbortSignal(T)) break :blk value.typeOf() == napi.napi_object;
+            if (comptime helper.isSmallString(T)) break :blk value.typeOf() == napi.napi_string;
+            if (comptime helper.isNapiFunction(T)) break :blk value.typeOf() == napi.napi_function;
+            if (comptime helper.isTypedArray(T)) break :blk value.isTypedArray() and typedArrayKindMatches(env, raw, T);
+            if (comptime helper.isDataView(T)) break :blk value.isDataView();
             if (comptime helper.isReference(T)) break :blk true;
             if (comptime helper.isExternal(T)) break :blk T.matches_napi_value(env, raw);
-            if (comptime helper.isTuple(T)) break :blk isArrayValue(env, raw);
-            if (comptime helper.isArrayList(T)) break :blk isArrayValue(env, raw) or isTypedArrayValue(env, raw);
-            break :blk isPlainObjectValue(env, raw);
+            if (comptime helper.isBorrowed(T)) break :blk value.typeOf() == napi.napi_object and T.matches_napi_value(env, raw);
+            if (comptime helper.isTuple(T)) break :blk value.isArray();
+            if (comptime helper.isArrayList(T)) break :blk value.isArray() or value.isTypedArray();
+            break :blk value.isPlainObject();
         },
         .@"union" => infos.@"union".tag_type != null,
-        .@"enum" => if (comptime isStringEnum(T)) napiTypeOf(env, raw) == napi.napi_string else napiTypeOf(env, raw) == napi.napi_number,
+        .@"enum" => if (comptime isStringEnum(T)) value.typeOf() == napi.napi_string else value.typeOf() == napi.napi_number,
         else => false,
     };
 }
 
 pub const Napi = struct {
+    /// Tracks slices already released while tearing down a converted value,
+    /// so aliased slices are freed once. The first few entries are scanned
+    /// linearly without allocating; larger values switch to an open-addressed
+    /// set, keeping teardown linear in the number of slices. Call `deinit`
+    /// when done.
     pub const DeinitState = struct {
         const Entry = struct {
             addr: usize,
             byte_len: usize,
         };
 
-        entries: [128]Entry = undefined,
+        const small_capacity = 8;
+        const empty_addr: usize = 0;
+
+        small: [small_capacity]Entry = undefined,
         len: usize = 0,
+        table: []Entry = &.{},
+
+        pub fn deinit(self: *DeinitState) void {
+            if (self.table.len != 0) {
+                GlobalAllocator.runtimeAllocator().free(self.table);
+            }
+            self.* = .{};
+        }
 
         fn shouldFree(self: *DeinitState, addr: usize, byte_len: usize) bool {
-            for (self.entries[0..self.len]) |entry| {
+            // Empty slices own no memory, so they never need deduplication.
+            if (byte_len == 0 or addr == empty_addr) return true;
+
+            if (self.table.len == 0) {
+                for (self.small[0..self.len]) |entry| {
+                    if (entry.addr == addr and entry.byte_len == byte_len) {
+                        return false;
+                    }
+                }
+                if (self.len < small_capacity) {
+                    self.small[self.len] = .{ .addr = addr, .byte_len = byte_len };
+                    self.len += 1;
+                    return true;
+                }
+                if (!self.grow(small_capacity * 8)) return true;
+            } else if ((self.len + 1) * 2 > self.table.len) {
+                if (!self.grow(self.table.len * 2)) return true;
+            }
+
+            return self.insert(addr, byte_len);
+        }
+
+        fn insert(self: *DeinitState, addr: usize, byte_len: usize) bool {
+            const mask = self.table.len - 1;
+            var index = std.hash.int(addr) & mask;
+            while (true) : (index = (index + 1) & mask) {
+                const entry = &self.table[index];
+                if (entry.addr == empty_addr) {
+                    entry.* = .{ .addr = addr, .byte_len = byte_len };
+                    self.len += 1;
+                    return true;
+                }
                 if (entry.addr == addr and entry.byte_len == byte_len) {
                     return false;
                 }
             }
-            if (self.len < self.entries.len) {
-                self.entries[self.len] = .{ .addr = addr, .byte_len = byte_len };
-                self.len += 1;
+        }
+
+        /// On allocation failure the state keeps its current entries and new
+        /// slices are freed without deduplication.
+        fn grow(self: *DeinitState, capacity: usize) bool {
+            const table = GlobalAllocator.runtimeAllocator().alloc(Entry, capacity) catch return false;
+            @memset(table, .{ .addr = empty_addr, .byte_len = 0 });
+
+            const previous = self.table;
+            const previous_len = self.len;
+            self.table = table;
+            self.len = 0;
+
+            if (previous.len == 0) {
+                for (self.small[0..previous_len]) |entry| {
+                    _ = self.insert(entry.addr, entry.byte_len);
+                }
+            } else {
+                for (previous) |entry| {
+                    if (entry.addr != empty_addr) {
+                        _ = self.insert(entry.addr, entry.byte_len);
+                    }
+                }
+                GlobalAllocator.runtimeAllocator().free(previous);
             }
             return true;
         }
@@ -363,8 +584,111 @@ pub const Napi = struct {
         return try Napi.to_napi_value(env, value, name);
     }
 
+    /// Struct types that only hold JavaScript handles and own no converted memory.
+    fn isJsHandleType(comptime T: type) bool {
+        return helper.isNapiFunction(T) or
+            helper.isTypedArray(T) or
+            helper.isDataView(T) or
+            helper.isReference(T) or
+            helper.isExternal(T) or
+            helper.isBorrowed(T) or
+            helper.isAbortSignal(T) or
+            T == NapiValue.NapiValue or
+            T == NapiValue.BigInt or
+            T == NapiValue.Bool or
+            T == NapiValue.Number or
+            T == NapiValue.String or
+            T == NapiValue.Object or
+            T == NapiValue.Promise or
+            T == NapiValue.Array or
+            T == NapiValue.Undefined or
+            T == NapiValue.Null or
+            T == Buffer or
+            T == ArrayBuffer or
+            T == DataView;
+    }
+
+    /// Whether a `T` converted from JavaScript still refers to a `napi_value`
+    /// of the current handle scope. Element loops only recycle handle scopes
+    /// for element types that do not.
+    pub fn holdsJsHandles(comptime T: type) bool {
+        return comptime holdsJsHandlesAtDepth(T, 0);
+    }
+
+    fn holdsJsHandlesAtDepth(comptime T: type, comptime depth: usize) bool {
+        if (depth > 16) return true;
+        if (helper.isDts(T)) return holdsJsHandlesAtDepth(T.wrapped_type, depth + 1);
+        if (isJsHandleType(T)) return true;
+        if (helper.isSmallString(T) or helper.stringLike(T) != .Unknown) return false;
+
+        return switch (@typeInfo(T)) {
+            .pointer => |ptr| holdsJsHandlesAtDepth(ptr.child, depth + 1),
+            .array => |arr| holdsJsHandlesAtDepth(arr.child, depth + 1),
+            .optional => |optional| holdsJsHandlesAtDepth(optional.child, depth + 1),
+            .@"struct" => |struct_info| blk: {
+                if (helper.isArrayList(T)) {
+                    break :blk holdsJsHandlesAtDepth(helper.getArrayListElementType(T), depth + 1);
+                }
+                for (struct_info.fields) |field| {
+                    if (holdsJsHandlesAtDepth(field.type, depth + 1)) break :blk true;
+                }
+                break :blk false;
+            },
+            .@"union" => |union_info| blk: {
+                for (union_info.fields) |field| {
+                    if (holdsJsHandlesAtDepth(field.type, depth + 1)) break :blk true;
+                }
+                break :blk false;
+            },
+            .@"opaque", .@"fn" => true,
+            else => false,
+        };
+    }
+
+    /// Whether a `T` converted from JavaScript can live in the per-call arena
+    /// (see `CallScope`). Values released through a custom `deinit`, and
+    /// `ArrayList`s that user code may grow with its own allocator, keep using
+    /// the operation allocator so their ownership rules are unchanged.
+    pub fn canUseCallArena(comptime T: type) bool {
+        return comptime canUseCallArenaAtDepth(T, 0);
+    }
+
+    fn canUseCallArenaAtDepth(comptime T: type, comptime depth: usize) bool {
+        // Self-referential payloads are rare; stay on the operation allocator.
+        if (depth > 16) return false;
+
+        if (comptime helper.stringLike(T) != .Unknown) return true;
+        if (comptime helper.isDts(T)) {
+            if (comptime !@hasField(T, "value")) return true;
+            return canUseCallArenaAtDepth(T.wrapped_type, depth + 1);
+        }
+
+        return switch (@typeInfo(T)) {
+            .array => |array| canUseCallArenaAtDepth(array.child, depth + 1),
+            .pointer => |ptr| ptr.size != .slice or canUseCallArenaAtDepth(ptr.child, depth + 1),
+            .optional => |optional| canUseCallArenaAtDepth(optional.child, depth + 1),
+            .@"struct" => |struct_info| blk: {
+                if (isJsHandleType(T)) break :blk true;
+                if (helper.isArrayList(T)) break :blk false;
+                if (@hasDecl(T, "deinit")) break :blk false;
+                for (struct_info.fields) |field| {
+                    if (!canUseCallArenaAtDepth(field.type, depth + 1)) break :blk false;
+                }
+                break :blk true;
+            },
+            .@"union" => |union_info| blk: {
+                for (union_info.fields) |field| {
+                    if (!canUseCallArenaAtDepth(field.type, depth + 1)) break :blk false;
+                }
+                break :blk true;
+            },
+            else => true,
+        };
+    }
+
     pub fn deinit_napi_value(comptime T: type, value: T) void {
         var state = DeinitState{};
+        defer state.deinit();
         Napi.deinit_napi_value_with_state(T, value, &state);
     }
 
@@ -460,26 +784,7 @@ pub const Napi = struct {
                 }
             },
             .@"struct" => {
-                if (comptime helper.isNapiFunction(T) or
-                    helper.isTypedArray(T) or
-                    helper.isDataView(T) or
-                    helper.isReference(T) or
-                    helper.isExternal(T) or
-                    helper.isAbortSignal(T) or
-                    T == NapiValue.NapiValue or
-                    T == NapiValue.BigInt or
-                    T == NapiValue.Bool or
-                    T == NapiValue.Number or
-                    T == NapiValue.String or
-                    T == NapiValue.Object or
-                    T == NapiValue.Promise or
-                    T == NapiValue.Array or
-                    T == NapiValue.Undefined or
-                    T == NapiValue.Null or
-                    T == Buffer or
-                    T == ArrayBuffer or
-                    T == DataView)
-                {
+                if (comptime isJsHandleType(T)) {
                     return;
                 }
 
@@ -553,6 +858,9 @@ pub const Napi = struct {
                             .pointer => {
                                 if (comptime helper.isSinglePointer(T)) {
                                     const child_info = @typeInfo(T).pointer.child;
+                                    if (comptime helper.isBatchedThreadSafeFunction(child_info)) {
+                                        return child_info.from_raw(env, raw);
+                                    }
                                     if (comptime helper.isThreadSafeFunction(child_info)) {
                                         const fn_infos = @typeInfo(child_info);
                                         comptime var args_type = void;
@@ -613,6 +921,12 @@ pub const Napi = struct {
                                 if (comptime helper.isExternal(T)) {
                                     return T.from_napi_value(env, raw);
                                 }
+                                if (comptime helper.isBorrowed(T)) {
+                                    return T.from_napi_value(env, raw);
+                                }
+                                if (comptime helper.isSmallString(T)) {
+                                    return T.from_napi_value(env, raw);
+                                }
 
                                 if (comptime helper.isTuple(T)) {
                                     return NapiValue.Array.from_napi_value(env, raw, T);
@@ -648,8 +962,11 @@ pub const Napi = struct {
                                     @compileError("Only tagged union(enum) is supported, got: " ++ @typeName(T));
                                 }
 
+                                var value_class = ValueClass.init(env, raw);
+                                const value_bit = value_class.typeBit();
                                 inline for (infos.@"union".fields) |field| {
-                                    if (valueMatchesType(env, raw, field.type)) {
+                                    const accepted = comptime acceptedValueTypes(field.type);
+                                    if (accepted & value_bit != 0 and valueMatchesClass(&value_class, field.type)) {
                                         return @unionInit(T, field.name, Napi.from_napi_value(env, raw, field.type));
                                     }
                                 }
@@ -772,6 +1089,12 @@ pub const Napi = struct {
                         if (comptime helper.isExternal(value_type)) {
                             return try value.to_napi_value(env);
                         }
+                        if (comptime helper.isBorrowed(value_type)) {
+                            return value.raw;
+                        }
+                        if (comptime helper.isSmallString(value_type)) {
+                            return NapiValue.String.New(Env.from_raw(env), value.slice()).raw;
+                        }
                         if (comptime helper.isTuple(value_type)) {
                             const array = try NapiValue.Array.New(Env.from_raw(env), value);
                             return array.raw;
@@ -780,6 +1103,9 @@ pub const Napi = struct {
                             const array = try NapiValue.Array.New(Env.from_raw(env), value);
                             return array.raw;
                         }
+                        if (comptime class.isClass(value_type)) {
+                            return value.raw;
+                        }
 
                         const object = try NapiValue.Object.New(Env.from_raw(env), value);
                         return object.raw;
@@ -789,7 +1115,7 @@ pub const Napi = struct {
                     },
                     .@"enum" => {
                         if (comptime isStringEnum(value_type)) {
-                            return NapiValue.String.New(Env.from_raw(env), @tagName(value)).raw;
+                            return stringEnumTag(env, value);
                         }
                         return NapiValue.Number.New(Env.from_raw(env), @intFromEnum(value)).raw;
                     },
@@ -834,3 +1160,25 @@ pub const Napi = struct {
         }
     }
 };
+
+test "DeinitState deduplicates past the inline entries" {
+    var state = Napi.DeinitState{};
+    defer state.deinit();
+
+    var addr: usize = 0x1000;
+    while (addr < 0x1000 + 4096 * 16) : (addr += 16) {
+        try std.testing.expect(state.shouldFree(addr, 16));
+    }
+    addr = 0x1000;
+    while (addr < 0x1000 + 4096 * 16) : (addr += 16) {
+        try std.testing.expect(!state.shouldFree(addr, 16));
+    }
+    try std.testing.expect(state.shouldFree(0x1000, 0));
+}
+
+test "acceptedValueTypes narrows union variants by typeof" {
+    try std.testing.expect(acceptedValueTypes(u32) == valueTypeBit(napi.napi_number));
+    try std.testing.expect(acceptedValueTypes([]const u8) == valueTypeBit(napi.napi_string));
+    try std.testing.expect(acceptedValueTypes(?bool) == valueTypeBit(napi.napi_null) | valueTypeBit(napi.napi_undefined) | valueTypeBit(napi.napi_boolean));
+    try std.testing.expect(acceptedValueTypes(struct { x: i32 }) == valueTypeBit(napi.napi_object));
+}
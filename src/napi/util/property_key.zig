@@ -0,0 +1,66 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const NapiError = @import("../wrapper/error.zig");
+const options = @import("../options.zig");
+const instance_data = @import("./instance_data.zig");
+
+/// Engines that expose `node_api_create_property_key_utf8` return an
+/// internalized string, which lets property lookups skip the string hash and
+/// hit the inline caches used for ordinary JS property access.
+fn supportsPropertyKeyApi() bool {
+    return options.isNodeAddon() and !options.isWasmNodeAddon() and options.selectedNapiVersion().isAtLeast(.v10);
+}
+
+/// Create a JS string suitable for use as a property key.
+pub fn create(env: napi.napi_env, key: []const u8) !napi.napi_value {
+    var raw: napi.napi_value = undefined;
+    const status = if (comptime supportsPropertyKeyApi())
+        napi.node_api_create_property_key_utf8(env, key.ptr, key.len, &raw)
+    else
+        napi.napi_create_string_utf8(env, key.ptr, key.len, &raw);
+    if (status != napi.napi_ok) {
+        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+    }
+    return raw;
+}
+
+/// Whether key strings can be held by a reference. Node only references
+/// primitives from Node-API v10 (or experimental builds, which sort above
+/// it); at lower versions every attempt fails, and a cache would only add
+/// calls in front of the `*_named_property` path.
+pub fn cachesKeys() bool {
+    return options.isOhosAddon() or options.selectedNapiVersion().isAtLeast(.v10);
+}
+
+/// Per-env cache for a comptime-known property key. The first lookup creates
+/// the key string; later lookups on the same env reuse it.
+pub fn PropertyKey(comptime name: [:0]const u8) type {
+    return struct {
+        const Slot = instance_data.RefSlot(@This());
+
+        pub const key = name;
+
+        /// The cached key, or a new key string where keys are not cached.
+        pub fn get(env: napi.napi_env) !napi.napi_value {
+            if (comptime !cachesKeys()) return create(env, name);
+            if (Slot.get(env)) |raw| return raw;
+
+            const raw = try create(env, name);
+            Slot.remember(env, raw);
+            return raw;
+        }
+
+        /// The cached key, or null where keys are not cached. Callers then
+        /// use the `*_named_property` calls with `key`.
+        pub fn cached(env: napi.napi_env) ?napi.napi_value {
+            if (comptime !cachesKeys()) return null;
+            return get(env) catch null;
+        }
+    };
+}
+
+test "PropertyKey keeps one slot per key" {
+    try std.testing.expectEqualStrings("width", PropertyKey("width").key);
+    try std.testing.expect(PropertyKey("width") == PropertyKey("width"));
+    try std.testing.expect(PropertyKey("width") != PropertyKey("height"));
+}
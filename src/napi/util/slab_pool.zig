@@ -0,0 +1,127 @@
+const std = @import("std");
+
+/// Fixed-size object pool that carves items out of slabs of `slab_len` and
+/// recycles released items through an intrusive free list, so steady-state
+/// acquire/release never reach the backing allocator.
+///
+/// A pool is single-threaded. Items may outlive `close`: the pool and its
+/// slabs are freed once the pool is closed and the last live item has been
+/// released.
+pub fn SlabPool(comptime Item: type, comptime slab_len: usize) type {
+    if (slab_len == 0) {
+        @compileError("SlabPool needs a non-zero slab length");
+    }
+
+    return struct {
+        allocator: std.mem.Allocator,
+        slabs: ?*Slab = null,
+        free: ?*FreeNode = null,
+        live: usize = 0,
+        closed: bool = false,
+
+        const Self = @This();
+
+        const FreeNode = struct {
+            next: ?*FreeNode,
+        };
+
+        const Cell = struct {
+            bytes: [@max(@sizeOf(Item), @sizeOf(FreeNode))]u8 align(@max(@alignOf(Item), @alignOf(FreeNode))),
+        };
+
+        const Slab = struct {
+            next: ?*Slab,
+            cells: [slab_len]Cell,
+        };
+
+        pub fn create(allocator: std.mem.Allocator) !*Self {
+            const self = try allocator.create(Self);
+            self.* = .{ .allocator = allocator };
+            return self;
+        }
+
+        /// Returns uninitialized storage for one item.
+        pub fn acquire(self: *Self) !*Item {
+            std.debug.assert(!self.closed);
+            if (self.free == null) try self.grow();
+
+            const node = self.free.?;
+            self.free = node.next;
+            self.live += 1;
+            return @ptrCast(@alignCast(node));
+        }
+
+        /// Returns `item` to the pool. The item must not be used afterwards.
+        pub fn release(self: *Self, item: *Item) void {
+            std.debug.assert(self.live > 0);
+            const node: *FreeNode = @ptrCast(@alignCast(item));
+            node.* = .{ .next = self.free };
+            self.free = node;
+            self.live -= 1;
+
+            if (self.closed and self.live == 0) self.destroy();
+        }
+
+        /// Stops handing out items and frees the pool once every live item has
+        /// been released.
+        pub fn close(self: *Self) void {
+            self.closed = true;
+            if (self.live == 0) self.destroy();
+        }
+
+        fn grow(self: *Self) !void {
+            const slab = try self.allocator.create(Slab);
+            slab.next = self.slabs;
+            self.slabs = slab;
+
+            var i = slab_len;
+            while (i > 0) {
+                i -= 1;
+                const node: *FreeNode = @ptrCast(@alignCast(&slab.cells[i]));
+                node.* = .{ .next = self.free };
+                self.free = node;
+            }
+        }
+
+        fn destroy(self: *Self) void {
+            var slab = self.slabs;
+            while (slab) |current| {
+                slab = current.next;
+                self.allocator.destroy(current);
+            }
+            self.allocator.destroy(self);
+        }
+    };
+}
+
+test "SlabPool recycles released items" {
+    const Pool = SlabPool(u64, 4);
+    const pool = try Pool.create(std.testing.allocator);
+
+    var items: [6]*u64 = undefined;
+    for (&items, 0..) |*item, i| {
+        item.* = try pool.acquire();
+        item.*.* = i;
+    }
+    try std.testing.expectEqual(@as(usize, 6), pool.live);
+
+    const released = items[5];
+    pool.release(released);
+    try std.testing.expect(try pool.acquire() == released);
+
+    for (items) |item| pool.release(item);
+    pool.close();
+}
+
+test "SlabPool outlives close until the last item is released" {
+    const Pool = SlabPool(u8, 2);
+    const pool = try Pool.create(std.testing.allocator);
+
+    const first = try pool.acquire();
+    const second = try pool.acquire();
+    const third = try pool.acquire();
+    pool.close();
+    pool.release(first);
+    pool.release(second);
+    pool.release(third);
+}
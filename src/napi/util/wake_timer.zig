@@ -0,0 +1,108 @@
+const std = @import("std");
+
+/// Longest single sleep of the timer thread. A deadline scheduled while the
+/// thread sleeps fires at most this late.
+const max_sleep_ns: u64 = std.time.ns_per_ms;
+
+/// Deferred wake-up embedded in its owner, such as a batched thread-safe
+/// function waiting for its latency bound. Entries are intrusive, so
+/// scheduling never allocates.
+pub const Entry = struct {
+    /// Runs on the timer thread with the timer lock held, so it must not
+    /// block or schedule. Posting a non-blocking wake-up is the intended use.
+    fire: *const fn (*Entry) void,
+    deadline_ns: u64 = 0,
+    next: ?*Entry = null,
+    scheduled: bool = false,
+};
+
+// Process-wide state. One detached thread serves every env; it parks on
+// `ready` while nothing is scheduled.
+var mutex: std.Io.Mutex = .init;
+var ready: std.Io.Condition = .init;
+var head: ?*Entry = null;
+var thread_started = false;
+
+fn timerIo() std.Io {
+    return std.Io.Threaded.global_single_threaded.io();
+}
+
+/// Monotonic clock reading that deadlines are expressed in.
+pub fn nowNs() u64 {
+    const reading = std.Io.Clock.awake.now(timerIo());
+    const timestamp = if (comptime @typeInfo(@TypeOf(reading)) == .error_union) reading catch return 0 else reading;
+    return @intCast(@max(timestamp.nanoseconds, 0));
+}
+
+/// Fires `entry` once `delay_ns` has passed. An entry that is already
+/// scheduled keeps its current deadline. If the timer thread cannot be
+/// started, the entry fires immediately.
+pub fn schedule(entry: *Entry, delay_ns: u64) void {
+    const io = timerIo();
+    mutex.lockUncancelable(io);
+    defer mutex.unlock(io);
+
+    if (entry.scheduled) return;
+    if (!thread_started) {
+        const thread = std.Thread.spawn(.{}, run, .{}) catch {
+            entry.fire(entry);
+            return;
+        };
+        thread.detach();
+        thread_started = true;
+    }
+
+    entry.deadline_ns = nowNs() +| delay_ns;
+    entry.scheduled = true;
+    var link = &head;
+    while (link.*) |current| : (link = &current.next) {
+        if (current.deadline_ns > entry.deadline_ns) break;
+    }
+    entry.next = link.*;
+    link.* = entry;
+    if (head == entry) ready.signal(io);
+}
+
+/// Unschedules `entry`. Once this returns, `fire` is not running and will not
+/// run for the cancelled schedule, so the owner may be freed.
+pub fn cancel(entry: *Entry) void {
+    const io = timerIo();
+    mutex.lockUncancelable(io);
+    defer mutex.unlock(io);
+
+    if (!entry.scheduled) return;
+    var link = &head;
+    while (link.*) |current| : (link = &current.next) {
+        if (current == entry) {
+            link.* = current.next;
+            break;
+        }
+    }
+    entry.next = null;
+    entry.scheduled = false;
+}
+
+fn run() void {
+    const io = timerIo();
+    mutex.lockUncancelable(io);
+    while (true) {
+        const first = head orelse {
+            ready.waitUncancelable(io, &mutex);
+            continue;
+        };
+
+        const now = nowNs();
+        if (first.deadline_ns > now) {
+            const sleep_ns = @min(first.deadline_ns - now, max_sleep_ns);
+            mutex.unlock(io);
+            io.sleep(.fromNanoseconds(@intCast(sleep_ns)), .awake) catch {};
+            mutex.lockUncancelable(io);
+            continue;
+        }
+
+        head = first.next;
+        first.next = null;
+        first.scheduled = false;
+        first.fire(first);
+    }
+}
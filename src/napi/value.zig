@@ -4,6 +4,7 @@ const Napi = @import("./util/napi.zig").Napi;
 pub const Object = @import("./value/object.zig").Object;
 pub const Number = @import("./value/number.zig").Number;
 pub const String = @import("./value/string.zig").String;
+pub const SmallString = @import("./value/string.zig").SmallString;
 pub const BigInt = @import("./value/bigint.zig").BigInt;
 pub const Null = @import("./value/null.zig").Null;
 pub const Undefined = @import("./value/undefined.zig").Undefined;
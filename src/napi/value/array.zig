@@ -9,6 +9,7 @@ const GlobalAllocator = @import("../util/allocator.zig");
 const typedarray = @import("../wrapper/typedarray.zig");
 const ArrayBuffer = @import("../wrapper/arraybuffer.zig").ArrayBuffer;
 const options = @import("../options.zig");
+const ElementScope = @import("../wrapper/handle_scope.zig").ElementScope;
 
 pub const Array = struct {
     env: napi.napi_env,
@@ -46,13 +47,17 @@ pub const Array = struct {
             .array => {
                 const array_len = infos.array.len;
 
+                var result: T = undefined;
+                var scope = elementScope(env, infos.array.child);
+                defer scope.end();
                 for (0..array_len) |i| {
+                    scope.next();
                     var element: napi.napi_value = undefined;
                     _ = napi.napi_get_element(env, raw, @intCast(i), &element);
-                    T[i] = Napi.from_napi_value_auto(env, element, infos.array.child);
+                    result[i] = Napi.from_napi_value_auto(env, element, infos.array.child);
                 }
 
-                return T;
+                return result;
             },
             .pointer => {
                 if (comptime helper.isSlice(T)) {
@@ -60,10 +65,13 @@ pub const Array = struct {
                     var len: u32 = undefined;
                     _ = napi.napi_get_array_length(env, raw, &len);
 
-                    const allocator = GlobalAllocator.globalAllocator();
+                    const allocator = GlobalAllocator.conversionAllocator();
                     const buf = allocator.alloc(infos.pointer.child, len) catch @panic("OOM");
 
+                    var scope = elementScope(env, infos.pointer.child);
+                    defer scope.end();
                     for (0..len) |i| {
+                        scope.next();
                         var element: napi.napi_value = undefined;
                         _ = napi.napi_get_element(env, raw, @intCast(i), &element);
                         buf[i] = Napi.from_napi_value_auto(env, element, infos.pointer.child);
@@ -87,13 +95,16 @@ pub const Array = struct {
                     // Get Array List's items type
                     const child = comptime helper.getArrayListElementType(T);
 
-                    const allocator = GlobalAllocator.globalAllocator();
+                    const allocator = GlobalAllocator.conversionAllocator();
 
                     var result: T = ArrayList(child).empty;
                     var len: u32 = undefined;
                     _ = napi.napi_get_array_length(env, raw, &len);
                     result.ensureTotalCapacity(allocator, len) catch @panic("OOM");
+                    var scope = elementScope(env, child);
+                    defer scope.end();
                     for (0..len) |i| {
+                        scope.next();
                         var element: napi.napi_value = undefined;
                         _ = napi.napi_get_element(env, raw, @intCast(i), &element);
                         result.append(allocator, Napi.from_napi_value_auto(env, element, child)) catch @panic("OOM");
@@ -108,6 +119,15 @@ pub const Array = struct {
         }
     }
 
+    /// Element types that keep a `napi_value` need it to outlive the loop, so
+    /// their loops never recycle the handle scope.
+    fn elementScope(env: napi.napi_env, comptime Element: type) ElementScope {
+        if (comptime Napi.holdsJsHandles(Element)) {
+            return ElementScope.begin(null);
+        }
+        return ElementScope.begin(env);
+    }
+
     fn numericCast(comptime Dst: type, value: anytype) Dst {
         const dst_info = @typeInfo(Dst);
         const src_info = @typeInfo(@TypeOf(value));
@@ -223,7 +243,7 @@ pub const Array = struct {
                     @compileError("TypedArray only supports numeric slice targets, got: " ++ @typeName(T));
                 }
 
-                const allocator = GlobalAllocator.globalAllocator();
+                const allocator = GlobalAllocator.conversionAllocator();
                 const buf = allocator.alloc(ptr.child, element_len) catch @panic("OOM");
                 fillFromTypedArray(ptr.child, buf, raw_type, data, element_len);
                 return buf;
@@ -235,7 +255,7 @@ pub const Array = struct {
                         @compileError("TypedArray only supports numeric ArrayList targets, got: " ++ @typeName(T));
                     }
 
-                    const allocator = GlobalAllocator.globalAllocator();
+                    const allocator = GlobalAllocator.conversionAllocator();
                     var result: T = ArrayList(child).empty;
                     result.ensureTotalCapacity(allocator, element_len) catch @panic("OOM");
                     const items = allocator.alloc(child, element_len) catch @panic("OOM");
@@ -276,8 +296,14 @@ pub const Array = struct {
             return NapiError.Error.fromStatus(NapiError.Status.New(status));
         }
 
+        // Each element is stored into the array right away, so its handle can
+        // be released with the scope.
+        var scope = ElementScope.begin(env.raw);
+        defer scope.end();
+
         if (infos == .array or comptime helper.isSlice(array_type)) {
             for (array, 0..) |item, i| {
+                scope.next();
                 const napi_value = try Napi.to_napi_value_auto(env.raw, item, null);
                 _ = napi.napi_set_element(env.raw, raw, @intCast(i), napi_value);
             }
@@ -289,6 +315,7 @@ pub const Array = struct {
             }
         } else if (comptime helper.isArrayList(array_type)) {
             for (array.items, 0..) |item, i| {
+                scope.next();
                 const napi_value = try Napi.to_napi_value_auto(env.raw, item, null);
                 _ = napi.napi_set_element(env.raw, raw, @intCast(i), napi_value);
             }
@@ -8,6 +8,7 @@ const Undefined = @import("./undefined.zig").Undefined;
 const Reference = @import("../wrapper/reference.zig").Reference;
 const helper = @import("../util/helper.zig");
 const AbortSignal = @import("../abort_signal.zig").AbortSignal;
+const GlobalAllocator = @import("../util/allocator.zig");
 
 pub fn Function(comptime Args: type, comptime Return: type) type {
     const ArgsInfos = @typeInfo(Args);
@@ -39,6 +40,16 @@ pub fn Function(comptime Args: type, comptime Return: type) type {
                 const has_env = params.len > 0 and params[0].type.? == Env;
                 const env_index = if (has_env) 1 else 0;
 
+                // Async descriptors take ownership of their arguments, so those are
+                // converted with the operation allocator and freed by the descriptor.
+                const uses_call_arena = blk: {
+                    if (helper.isAsyncDescriptor(returnPayloadType(infos.@"fn".return_type.?))) break :blk false;
+                    for (params[env_index..]) |param| {
+                        if (!Napi.canUseCallArena(param.type.?)) break :blk false;
+                    }
+                    break :blk true;
+                };
+
                 fn cleanupArgs(args: *std.meta.ArgsTuple(value_type), initialized: usize) void {
                     inline for (params, 0..) |param, i| {
                         if (comptime has_env and i == 0) {
@@ -132,9 +143,15 @@ pub fn Function(comptime Args: type, comptime Return: type) type {
                         }
                     }
 
+                    var call_scope = if (comptime uses_call_arena)
+                        GlobalAllocator.CallScope.begin()
+                    else
+                        GlobalAllocator.CallScope.beginOwned();
+                    defer call_scope.end();
+
                     var napi_params: std.meta.ArgsTuple(value_type) = undefined;
                     var initialized_params: usize = 0;
-                    var cleanup_params = true;
+                    var cleanup_params = !uses_call_arena;
                     defer if (cleanup_params) cleanupArgs(&napi_params, initialized_params);
 
                     if (comptime has_env) {
@@ -158,6 +175,8 @@ pub fn Function(comptime Args: type, comptime Return: type) type {
                         }
                     }
 
+                    call_scope.endConversion();
+
                     const event_listener = if (has_async_events and copied_argc > params.len - env_index)
                         args_raw[copied_argc - 1]
                     else
@@ -15,6 +15,7 @@ const NapiError = @import("../wrapper/error.zig");
 const Reference = @import("../wrapper/reference.zig").Reference;
 const native_wrap = @import("../wrapper/native_wrap.zig");
 const options = @import("../options.zig");
+const property_key = @import("../util/property_key.zig");
 
 pub const Object = struct {
     env: napi.napi_env,
@@ -38,7 +39,11 @@ pub const Object = struct {
                 var result: T = undefined;
                 inline for (infos.@"struct".fields) |field| {
                     var element: napi.napi_value = undefined;
-                    _ = napi.napi_get_named_property(env, raw, @ptrCast(field.name.ptr), &element);
+                    if (property_key.PropertyKey(field.name).cached(env)) |key_raw| {
+                        _ = napi.napi_get_property(env, raw, key_raw, &element);
+                    } else {
+                        _ = napi.napi_get_named_property(env, raw, @ptrCast(field.name.ptr), &element);
+                    }
                     @field(result, field.name) = Napi.from_napi_value_auto(env, element, field.type);
                 }
                 return result;
@@ -70,28 +75,101 @@ pub const Object = struct {
             @compileError("Object.New does not support tuple type");
         }
 
-        var self = try Object.Create(env);
-
         const obj_fields = obj_infos.@"struct".fields;
+        if (obj_fields.len == 0) {
+            return Object.Create(env);
+        }
 
-        inline for (obj_fields) |field| {
-            const n_value = try Napi.to_napi_value_auto(env.raw, @field(obj, field.name), field.name);
-            try self.Set(
-                field.name,
-                n_value,
-            );
+        var values: [obj_fields.len]napi.napi_value = undefined;
+        inline for (obj_fields, 0..) |field, i| {
+            values[i] = try Napi.to_napi_value_auto(env.raw, @field(obj, field.name), field.name);
         }
 
-        return self;
+        const names = comptime blk: {
+            var result: [obj_fields.len][:0]const u8 = undefined;
+            for (obj_fields, 0..) |field, i| {
+                result[i] = field.name;
+            }
+            break :blk result;
+        };
+        return Object.NewWithNamedValues(env, &names, &values);
     }
 
-    fn keyToNapiValue(self: Object, key: []const u8) !napi.napi_value {
-        var key_raw: napi.napi_value = undefined;
-        const status = napi.napi_create_string_utf8(self.env, key.ptr, key.len, &key_raw);
+    /// Build an object from comptime-known keys and already converted values
+    /// in one step, so the engine assigns the final shape at once instead of
+    /// transitioning it once per property.
+    ///
+    /// OpenHarmony uses `napi_create_object_with_named_properties`; other
+    /// runtimes create the object and install every value with a single
+    /// `napi_define_properties` call keyed by the per-env key cache.
+    pub fn NewWithNamedValues(env: Env, comptime names: []const [:0]const u8, values: *const [names.len]napi.napi_value) !Object {
+        if (comptime canCreateWithNamedProperties(names)) {
+            const keys = comptime blk: {
+                var result: [names.len][*c]const u8 = undefined;
+                for (names, 0..) |name, i| {
+                    result[i] = name.ptr;
+                }
+                break :blk result;
+            };
+
+            var raw: napi.napi_value = undefined;
+            const status = napi.napi_create_object_with_named_properties(env.raw, &raw, names.len, @constCast(&keys), values);
+            if (status == napi.napi_ok) {
+                return Object.from_raw(env.raw, raw);
+            }
+        }
+
+        const self = try Object.Create(env);
+
+        var descriptors: [names.len]napi.napi_property_descriptor = undefined;
+        inline for (names, 0..) |name, i| {
+            const key_raw = property_key.PropertyKey(name).cached(env.raw);
+            const utf8name: [*c]const u8 = if (key_raw == null) name.ptr else null;
+            descriptors[i] = napi.napi_property_descriptor{
+                .utf8name = utf8name,
+                .name = key_raw,
+                .method = null,
+                .getter = null,
+                .setter = null,
+                .value = values[i],
+                .attributes = napi.napi_writable | napi.napi_enumerable | napi.napi_configurable,
+                .data = null,
+            };
+        }
+
+        const status = napi.napi_define_properties(env.raw, self.raw, names.len, &descriptors);
         if (status != napi.napi_ok) {
             return NapiError.Error.fromStatus(NapiError.Status.New(status));
         }
-        return key_raw;
+
+        return self;
+    }
+
+    /// The OpenHarmony batch constructor rejects duplicate keys and keys that
+    /// look like array indices, so those objects take the portable path.
+    fn canCreateWithNamedProperties(comptime names: []const [:0]const u8) bool {
+        if (!options.isOhosAddon() or !@hasDecl(napi, "napi_create_object_with_named_properties")) {
+            return false;
+        }
+        for (names, 0..) |name, i| {
+            if (name.len == 0) return false;
+            var is_index = true;
+            for (name) |c| {
+                if (c < '0' or c > '9') {
+                    is_index = false;
+                    break;
+                }
+            }
+            if (is_index) return false;
+            for (names[0..i]) |previous| {
+                if (std.mem.eql(u8, previous, name)) return false;
+            }
+        }
+        return true;
+    }
+
+    fn keyToNapiValue(self: Object, key: []const u8) !napi.napi_value {
+        return property_key.create(self.env, key);
     }
 
     pub fn Set(self: Object, key: []const u8, value: anytype) !void {
@@ -103,6 +181,19 @@ pub const Object = struct {
         }
     }
 
+    /// Like `Set`, but the key string is created once per env and reused
+    /// where keys can be cached (see `property_key.cachesKeys`).
+    pub fn SetNamed(self: Object, comptime key: [:0]const u8, value: anytype) !void {
+        const n_value = try Napi.to_napi_value_auto(self.env, value, null);
+        const status = if (property_key.PropertyKey(key).cached(self.env)) |key_raw|
+            napi.napi_set_property(self.env, self.raw, key_raw, n_value)
+        else
+            napi.napi_set_named_property(self.env, self.raw, key.ptr, n_value);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+    }
+
     pub fn SetProperty(self: Object, key: anytype, value: anytype) !void {
         const key_raw = try Napi.to_napi_value_auto(self.env, key, null);
         const n_value = try Napi.to_napi_value_auto(self.env, value, null);
@@ -125,7 +216,11 @@ pub const Object = struct {
 
     pub fn GetNamed(self: Object, comptime key: []const u8, comptime T: type) T {
         var raw: napi.napi_value = undefined;
-        _ = napi.napi_get_named_property(self.env, self.raw, @ptrCast(key.ptr), &raw);
+        if (property_key.PropertyKey(std.fmt.comptimePrint("{s}", .{key})).cached(self.env)) |key_raw| {
+            _ = napi.napi_get_property(self.env, self.raw, key_raw, &raw);
+        } else {
+            _ = napi.napi_get_named_property(self.env, self.raw, @ptrCast(key.ptr), &raw);
+        }
         return Napi.from_napi_value_auto(self.env, raw, T);
     }
 
@@ -4,6 +4,25 @@ const Value = @import("../value.zig").Value;
 const Env = @import("../env.zig").Env;
 const helper = @import("../util/helper.zig");
 const GlobalAllocator = @import("../util/allocator.zig");
+const NapiError = @import("../wrapper/error.zig");
+const options = @import("../options.zig");
+
+/// Code units decoded on the stack before falling back to a length query.
+const short_string_capacity = 64;
+
+/// Units in a probe buffer that decides in one call whether a string of up to
+/// `capacity` units is complete. The engine stops UTF-8 output at a character
+/// boundary, so a truncated copy can leave up to three bytes unused; one more
+/// unit tells a truncated copy from an exact fit, and one holds the terminator.
+fn probeLength(comptime T: type, comptime capacity: usize) usize {
+    return capacity + (if (T == u8) 3 else 0) + 2;
+}
+
+/// Whether a copy of `copied` units into a `probeLength(T, capacity)` buffer
+/// is the whole string.
+fn fitsCompletely(copied: usize, capacity: usize) bool {
+    return copied <= capacity;
+}
 
 pub const String = struct {
     env: napi.napi_env,
@@ -26,22 +45,30 @@ pub const String = struct {
         return len;
     }
 
+    /// Copy the string as UTF-8. The caller owns the result and frees it with
+    /// `napi.globalAllocator()`.
     pub fn copyUtf8(self: String) []u8 {
-        return String.from_napi_value(self.env, self.raw, []u8);
+        var len: usize = 0;
+        _ = napi.napi_get_value_string_utf8(self.env, self.raw, null, 0, &len);
+        return copyNullTerminated(u8, napi.napi_get_value_string_utf8, GlobalAllocator.globalAllocator(), self.env, self.raw, len);
     }
 
+    /// Copy the string as UTF-16. The caller owns the result and frees it with
+    /// `napi.globalAllocator()`.
     pub fn copyUtf16(self: String) []u16 {
-        return String.from_napi_value(self.env, self.raw, []u16);
+        var len: usize = 0;
+        _ = napi.napi_get_value_string_utf16(self.env, self.raw, null, 0, &len);
+        return copyNullTerminated(u16, napi.napi_get_value_string_utf16, GlobalAllocator.globalAllocator(), self.env, self.raw, len);
     }
 
     fn copyNullTerminated(
         comptime T: type,
         comptime get_value: *const fn (napi.napi_env, napi.napi_value, [*c]T, usize, ?*usize) callconv(.c) napi.napi_status,
+        allocator: std.mem.Allocator,
         env: napi.napi_env,
         raw: napi.napi_value,
         len: usize,
     ) []T {
-        const allocator = GlobalAllocator.globalAllocator();
         if (len == 0) {
             return allocator.alloc(T, 0) catch @panic("OOM");
         }
@@ -59,21 +86,49 @@ pub const String = struct {
         return owned;
     }
 
+    /// Decode a short string with a single engine call into a stack buffer.
+    /// Returns null when the string may not have fit, in which case the caller
+    /// falls back to the length query + copy path.
+    fn copyShort(
+        comptime T: type,
+        comptime get_value: *const fn (napi.napi_env, napi.napi_value, [*c]T, usize, ?*usize) callconv(.c) napi.napi_status,
+        allocator: std.mem.Allocator,
+        env: napi.napi_env,
+        raw: napi.napi_value,
+    ) ?[]T {
+        var stack: [probeLength(T, short_string_capacity)]T = undefined;
+        var copied: usize = 0;
+        if (get_value(env, raw, &stack, stack.len, &copied) != napi.napi_ok) return null;
+        if (!fitsCompletely(copied, short_string_capacity)) return null;
+
+        const owned = allocator.alloc(T, copied) catch @panic("OOM");
+        @memcpy(owned, stack[0..copied]);
+        return owned;
+    }
+
     pub fn from_napi_value(env: napi.napi_env, raw: napi.napi_value, comptime T: type) T {
         const stringMode = comptime helper.stringLike(T);
         switch (stringMode) {
             .Utf8 => {
+                if (copyShort(u8, napi.napi_get_value_string_utf8, GlobalAllocator.conversionAllocator(), env, raw)) |buf| {
+                    return @as(T, buf);
+                }
+
                 var len: usize = 0;
                 _ = napi.napi_get_value_string_utf8(env, raw, null, 0, &len);
 
-                const buf = copyNullTerminated(u8, napi.napi_get_value_string_utf8, env, raw, len);
+                const buf = copyNullTerminated(u8, napi.napi_get_value_string_utf8, GlobalAllocator.conversionAllocator(), env, raw, len);
                 return @as(T, buf);
             },
             .Utf16 => {
+                if (copyShort(u16, napi.napi_get_value_string_utf16, GlobalAllocator.conversionAllocator(), env, raw)) |buf| {
+                    return @as(T, buf);
+                }
+
                 var len: usize = 0;
                 _ = napi.napi_get_value_string_utf16(env, raw, null, 0, &len);
 
-                const buf = copyNullTerminated(u16, napi.napi_get_value_string_utf16, env, raw, len);
+                const buf = copyNullTerminated(u16, napi.napi_get_value_string_utf16, GlobalAllocator.conversionAllocator(), env, raw, len);
                 return @as(T, buf);
             },
             else => {
@@ -87,4 +142,215 @@ pub const String = struct {
         _ = napi.napi_create_string_utf8(env.raw, value.ptr, value.len, &raw);
         return String.from_raw(env.raw, raw);
     }
+
+    /// Create a string that references `data` instead of copying it into the
+    /// JavaScript heap. Pure-ASCII text takes the one-byte external path; other
+    /// UTF-8 text, and runtimes without external strings (OpenHarmony, wasm,
+    /// Node-API below v10), fall back to a regular copy.
+    ///
+    /// Pass `owner` when `data` was allocated by that allocator: ownership moves
+    /// to the string and `data` is freed when JavaScript releases it (or right
+    /// away when the engine copied). Pass `null` for memory that outlives the
+    /// addon, such as `@embedFile` tables and string literals.
+    pub fn external(env: Env, data: []const u8, owner: ?std.mem.Allocator) !String {
+        if (isAscii(data)) {
+            return String.externalLatin1(env, data, owner);
+        }
+
+        var raw: napi.napi_value = undefined;
+        const status = napi.napi_create_string_utf8(env.raw, data.ptr, data.len, &raw);
+        if (owner) |allocator| allocator.free(data);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+        return String.from_raw(env.raw, raw);
+    }
+
+    /// Like `external`, for bytes that are already Latin-1 encoded.
+    pub fn externalLatin1(env: Env, data: []const u8, owner: ?std.mem.Allocator) !String {
+        if (comptime supportsExternalStrings()) {
+            if (createExternal(u8, napi.node_api_create_external_string_latin1, env, data, owner)) |raw| {
+                return String.from_raw(env.raw, raw);
+            }
+        }
+
+        var raw: napi.napi_value = undefined;
+        const status = napi.napi_create_string_latin1(env.raw, data.ptr, data.len, &raw);
+        if (owner) |allocator| allocator.free(data);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+        return String.from_raw(env.raw, raw);
+    }
+
+    /// Like `external`, for UTF-16 code units.
+    pub fn externalUtf16(env: Env, data: []const u16, owner: ?std.mem.Allocator) !String {
+        if (comptime supportsExternalStrings()) {
+            if (createExternal(u16, napi.node_api_create_external_string_utf16, env, data, owner)) |raw| {
+                return String.from_raw(env.raw, raw);
+            }
+        }
+
+        var raw: napi.napi_value = undefined;
+        const status = napi.napi_create_string_utf16(env.raw, data.ptr, data.len, &raw);
+        if (owner) |allocator| allocator.free(data);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+        return String.from_raw(env.raw, raw);
+    }
+
+    fn supportsExternalStrings() bool {
+        return options.isNodeAddon() and !options.isWasmNodeAddon() and options.selectedNapiVersion().isAtLeast(.v10);
+    }
+
+    /// Returns null when the engine refused the external string or its
+    /// finalizer hint could not be allocated. Nothing was taken over then, so
+    /// the caller can fall back to a copy.
+    fn createExternal(
+        comptime T: type,
+        comptime create: *const fn (napi.napi_env, [*c]T, usize, napi.node_api_basic_finalize, ?*anyopaque, [*c]napi.napi_value, [*c]bool) callconv(.c) napi.napi_status,
+        env: Env,
+        data: []const T,
+        owner: ?std.mem.Allocator,
+    ) ?napi.napi_value {
+        if (data.len == 0) return null;
+
+        // Without a hint the caller's copy path still frees `data`.
+        const hint: ?*ExternalStringHint(T) = if (owner) |allocator|
+            ExternalStringHint(T).create(allocator, data) catch return null
+        else
+            null;
+
+        var raw: napi.napi_value = undefined;
+        var copied = false;
+        const status = create(
+            env.raw,
+            @constCast(data.ptr),
+            data.len,
+            if (hint != null) ExternalStringHint(T).finalize else null,
+            hint,
+            &raw,
+            &copied,
+        );
+        if (status != napi.napi_ok) {
+            if (hint) |actual_hint| actual_hint.destroyHint();
+            return null;
+        }
+        // When `copied` is set the engine already ran the finalizer.
+        return raw;
+    }
 };
+
+fn ExternalStringHint(comptime T: type) type {
+    return struct {
+        allocator: std.mem.Allocator,
+        data: []const T,
+
+        const Self = @This();
+
+        fn create(allocator: std.mem.Allocator, data: []const T) !*Self {
+            const hint_allocator = GlobalAllocator.globalAllocator();
+            const hint = try hint_allocator.create(Self);
+            hint.* = .{ .allocator = allocator, .data = data };
+            return hint;
+        }
+
+        fn destroyHint(self: *Self) void {
+            GlobalAllocator.globalAllocator().destroy(self);
+        }
+
+        fn finalize(_: napi.napi_env, _: ?*anyopaque, hint: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(hint orelse return));
+            self.allocator.free(self.data);
+            self.destroyHint();
+        }
+    };
+}
+
+/// SIMD scan for bytes with the high bit set.
+fn isAscii(bytes: []const u8) bool {
+    const lanes = comptime std.simd.suggestVectorLength(u8) orelse 16;
+    const Chunk = @Vector(lanes, u8);
+    const high_bits: Chunk = @splat(0x80);
+
+    var i: usize = 0;
+    while (i + lanes <= bytes.len) : (i += lanes) {
+        const chunk: Chunk = bytes[i..][0..lanes].*;
+        if (@reduce(.Or, chunk & high_bits) != 0) return false;
+    }
+    for (bytes[i..]) |byte| {
+        if (byte & 0x80 != 0) return false;
+    }
+    return true;
+}
+
+/// UTF-8 string argument decoded into `N` inline bytes.
+///
+/// Strings up to `N` bytes are read with a single engine call and no heap
+/// allocation, which suits ids, keys and enum-like tags. Longer strings fall
+/// back to a heap copy owned by the conversion layer.
+pub fn SmallString(comptime N: usize) type {
+    if (N == 0) {
+        @compileError("SmallString capacity must be greater than zero");
+    }
+
+    return struct {
+        pub const is_napi_small_string = true;
+        pub const inline_capacity = N;
+
+        inline_bytes: [probeLength(u8, N)]u8 = undefined,
+        inline_len: usize = 0,
+        heap: ?[]u8 = null,
+
+        const Self = @This();
+
+        pub fn from_napi_value(env: napi.napi_env, raw: napi.napi_value) Self {
+            var result = Self{};
+            var copied: usize = 0;
+            const status = napi.napi_get_value_string_utf8(env, raw, &result.inline_bytes, result.inline_bytes.len, &copied);
+            if (status != napi.napi_ok) {
+                NapiError.last_error = NapiError.Error.withStatus(NapiError.Status.New(status));
+                return result;
+            }
+            result.inline_len = copied;
+            if (fitsCompletely(copied, N)) return result;
+
+            var len: usize = 0;
+            _ = napi.napi_get_value_string_utf8(env, raw, null, 0, &len);
+            if (len == copied) return result;
+
+            result.heap = String.copyNullTerminated(u8, napi.napi_get_value_string_utf8, GlobalAllocator.conversionAllocator(), env, raw, len);
+            result.inline_len = 0;
+            return result;
+        }
+
+        pub fn slice(self: *const Self) []const u8 {
+            if (self.heap) |heap| return heap;
+            return self.inline_bytes[0..self.inline_len];
+        }
+
+        pub fn length(self: *const Self) usize {
+            return self.slice().len;
+        }
+
+        pub fn isInline(self: *const Self) bool {
+            return self.heap == null;
+        }
+    };
+}
+
+test "probe buffers decide strings up to their capacity in one call" {
+    // "ArkTS" into SmallString(8): a five-byte copy cannot be truncated.
+    try std.testing.expect(fitsCompletely(5, 8));
+    try std.testing.expect(fitsCompletely(8, 8));
+    try std.testing.expect(!fitsCompletely(9, 8));
+    try std.testing.expectEqual(@as(usize, 13), probeLength(u8, 8));
+    try std.testing.expectEqual(@as(usize, 10), probeLength(u16, 8));
+}
+
+test "isAscii detects non-ASCII bytes past the vector tail" {
+    try std.testing.expect(isAscii("plain ascii text that spans more than one vector chunk"));
+    try std.testing.expect(!isAscii("plain ascii text that spans more than one vector chunk \xc3\xa9"));
+    try std.testing.expect(isAscii(""));
+}
@@ -0,0 +1,353 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const Napi = @import("../util/napi.zig").Napi;
+const Undefined = @import("../value/undefined.zig").Undefined;
+const Env = @import("../env.zig").Env;
+const NapiError = @import("./error.zig");
+const String = @import("../value/string.zig").String;
+const GlobalAllocator = @import("../util/allocator.zig");
+const options = @import("../options.zig");
+const typedarray = @import("./typedarray.zig");
+const thread_safe_function = @import("./thread_safe_function.zig");
+const function_cache = @import("../util/function_cache.zig");
+const wake_timer = @import("../util/wake_timer.zig");
+
+const ThreadSafeFunctionMode = thread_safe_function.ThreadSafeFunctionMode;
+const ThreadSafeFunctionReleaseMode = thread_safe_function.ThreadSafeFunctionReleaseMode;
+
+pub const BatchOptions = struct {
+    /// Ring slots preallocated per function. Must be a power of two.
+    capacity: usize = 1024,
+    /// Most items passed to one JS call. A wake-up that finds more pending
+    /// items calls the callback again with the next batch.
+    max_batch: usize = 256,
+    /// Pending items that trigger a wake-up of the JS thread. Items below
+    /// the threshold wait for the next push that reaches it, `flush()`,
+    /// `release()`, or `max_delay_ns`.
+    flush_threshold: usize = 1,
+    /// Longest time the oldest pending item may wait below `flush_threshold`
+    /// before the JS thread is woken anyway. Checked on every push and
+    /// enforced by a timer when no push follows. 0 disables the bound.
+    max_delay_ns: u64 = 0,
+};
+
+/// Bounded multi-producer, single-consumer ring (Vyukov). Every cell carries
+/// a sequence number, so producers claim a cell with one CAS and publish it
+/// with one store; the consumer never takes a lock.
+fn Ring(comptime Item: type, comptime capacity: usize) type {
+    if (capacity == 0 or !std.math.isPowerOfTwo(capacity)) {
+        @compileError(std.fmt.comptimePrint("BatchedThreadSafeFunction capacity must be a power of two, got: {d}", .{capacity}));
+    }
+
+    return struct {
+        cells: [capacity]Cell,
+        enqueue_pos: std.atomic.Value(usize) = .init(0),
+        dequeue_pos: usize = 0,
+
+        const Self = @This();
+        const mask = capacity - 1;
+
+        const Cell = struct {
+            sequence: std.atomic.Value(usize),
+            item: Item,
+        };
+
+        fn init(self: *Self) void {
+            for (&self.cells, 0..) |*cell, i| {
+                cell.sequence = .init(i);
+            }
+            self.enqueue_pos = .init(0);
+            self.dequeue_pos = 0;
+        }
+
+        /// Returns false when the ring is full.
+        fn push(self: *Self, item: Item) bool {
+            var pos = self.enqueue_pos.load(.monotonic);
+            while (true) {
+                const cell = &self.cells[pos & mask];
+                const sequence = cell.sequence.load(.acquire);
+                const diff: isize = @bitCast(sequence -% pos);
+                if (diff == 0) {
+                    pos = self.enqueue_pos.cmpxchgWeak(pos, pos +% 1, .monotonic, .monotonic) orelse {
+                        cell.item = item;
+                        cell.sequence.store(pos +% 1, .release);
+                        return true;
+                    };
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = self.enqueue_pos.load(.monotonic);
+                }
+            }
+        }
+
+        /// Consumer side only.
+        fn pop(self: *Self) ?Item {
+            const pos = self.dequeue_pos;
+            const cell = &self.cells[pos & mask];
+            if (cell.sequence.load(.acquire) != pos +% 1) return null;
+
+            const item = cell.item;
+            cell.sequence.store(pos +% capacity, .release);
+            self.dequeue_pos = pos +% 1;
+            return item;
+        }
+    };
+}
+
+/// Thread-safe function that coalesces items from native threads and hands
+/// them to JavaScript in batches: `(batch) => void`.
+///
+/// Producers write into a preallocated lock-free ring. Only the push that
+/// finds no wake-up in flight calls `napi_call_threadsafe_function`, and the
+/// JS thread drains everything pending in that wake-up. Numeric items are
+/// delivered as a packed TypedArray, other items as a JS array.
+pub fn BatchedThreadSafeFunction(comptime Item: type, comptime batch_options: BatchOptions) type {
+    comptime options.requireNapiVersion(.v4);
+
+    if (batch_options.max_batch == 0 or batch_options.flush_threshold == 0) {
+        @compileError("BatchedThreadSafeFunction needs a non-zero max_batch and flush_threshold");
+    }
+
+    return struct {
+        env: napi.napi_env,
+        raw: napi.napi_value,
+        tsfn_raw: napi.napi_threadsafe_function,
+        allocator: std.mem.Allocator,
+        ring: RingType,
+        pending: std.atomic.Value(usize),
+        wake_pending: std.atomic.Value(bool),
+        batch: [max_batch]Item,
+        cache: ?*function_cache.FunctionCache,
+        /// When the oldest item still waiting below the threshold arrived.
+        first_pending_ns: std.atomic.Value(u64),
+        delay_timer: wake_timer.Entry,
+
+        const Self = @This();
+        const RingType = Ring(Item, batch_options.capacity);
+        const max_batch = batch_options.max_batch;
+        const max_delay_ns = batch_options.max_delay_ns;
+
+        pub const is_napi_batched_tsfn = true;
+        pub const item_type = Item;
+        pub const packed_items = typedarray.isSupportedElementType(Item);
+        /// The value type handed to the JS callback.
+        pub const Batch = if (packed_items) typedarray.TypedArray(Item) else []const Item;
+
+        /// Marks this instantiation in the per-function cache.
+        var cache_key: u8 = 0;
+
+        /// Returns the batched function for the JS function `raw`, with one
+        /// thread use owned by the caller. Like `ThreadSafeFunction`, the
+        /// instance is cached on the JS function and acquired again when the
+        /// same callback is converted while it is still alive. Holders share
+        /// one ring, so `release(.Abort)` from one closes it for all.
+        pub fn from_raw(env: napi.napi_env, raw: napi.napi_value) *Self {
+            if (function_cache.lookup(env, raw, &cache_key)) |cached| {
+                const self: *Self = @ptrCast(@alignCast(cached));
+                if (self.acquire()) |_| return self else |_| {}
+            }
+
+            const self = create(env, raw);
+            self.cache = function_cache.remember(env, raw, &cache_key, self, detachCache);
+            return self;
+        }
+
+        fn detachCache(ptr: *anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ptr));
+            self.cache = null;
+        }
+
+        fn create(env: napi.napi_env, raw: napi.napi_value) *Self {
+            const allocator = GlobalAllocator.globalAllocator();
+            var self = allocator.create(Self) catch @panic("OOM");
+            self.env = env;
+            self.raw = raw;
+            self.tsfn_raw = null;
+            self.allocator = allocator;
+            self.ring.init();
+            self.pending = .init(0);
+            self.wake_pending = .init(false);
+            self.cache = null;
+            self.first_pending_ns = .init(0);
+            self.delay_timer = .{ .fire = delayExpired };
+
+            var tsfn_raw: napi.napi_threadsafe_function = null;
+            const resource = String.New(Env.from_raw(env), "BatchedThreadSafeFunction");
+            const create_status = napi.napi_create_threadsafe_function(
+                env,
+                raw,
+                null,
+                resource.raw,
+                0,
+                1,
+                @ptrCast(self),
+                finalize,
+                @ptrCast(self),
+                drain,
+                &tsfn_raw,
+            );
+            if (create_status != napi.napi_ok) {
+                allocator.destroy(self);
+                @panic("Failed to create BatchedThreadSafeFunction");
+            }
+
+            self.tsfn_raw = tsfn_raw;
+            return self;
+        }
+
+        pub fn deinit(self: *Self) void {
+            self.allocator.destroy(self);
+        }
+
+        fn finalize(_: napi.napi_env, data: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(data));
+            if (comptime max_delay_ns != 0) wake_timer.cancel(&self.delay_timer);
+            if (self.cache) |cache| cache.forget(self);
+            self.deinit();
+        }
+
+        fn drain(inner_env: napi.napi_env, js_callback: napi.napi_value, context: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
+            const self: *Self = @ptrCast(@alignCast(context));
+            // Clear first, so a push that lands while we drain schedules a
+            // new wake-up instead of waiting behind this one.
+            self.wake_pending.store(false, .release);
+
+            // Bound the drain by what was pending on entry, so fast producers
+            // cannot keep the JS thread here indefinitely.
+            var budget = self.pending.load(.acquire);
+            while (budget > 0) {
+                var count: usize = 0;
+                while (count < @min(budget, max_batch)) : (count += 1) {
+                    self.batch[count] = self.ring.pop() orelse break;
+                }
+                if (count == 0) break;
+                _ = self.pending.fetchSub(count, .acq_rel);
+                budget -= count;
+
+                // The env is shutting down; drop what is left.
+                if (inner_env == null or js_callback == null) continue;
+                deliver(inner_env, js_callback, self.batch[0..count]);
+            }
+
+            const left = self.pending.load(.acquire);
+            if (left >= batch_options.flush_threshold) {
+                self.wake() catch {};
+            } else if (left > 0) {
+                self.startDelay();
+            }
+        }
+
+        /// Starts the latency bound for items now waiting below the
+        /// threshold.
+        fn startDelay(self: *Self) void {
+            if (comptime max_delay_ns == 0) return;
+            self.first_pending_ns.store(wake_timer.nowNs(), .release);
+            wake_timer.schedule(&self.delay_timer, max_delay_ns);
+        }
+
+        fn delayExpired(entry: *wake_timer.Entry) void {
+            const self: *Self = @fieldParentPtr("delay_timer", entry);
+            if (self.pending.load(.acquire) == 0) return;
+            self.wake() catch {};
+        }
+
+        fn deliver(inner_env: napi.napi_env, js_callback: napi.napi_value, items: []const Item) void {
+            const env = Env.from_raw(inner_env);
+            const argv = [_]napi.napi_value{
+                if (comptime packed_items)
+                    (Batch.copy(env, items) catch return).raw
+                else
+                    Napi.to_napi_value(inner_env, items, null) catch return,
+            };
+            var ret: napi.napi_value = undefined;
+            _ = napi.napi_call_function(inner_env, Undefined.New(env).raw, js_callback, argv.len, &argv, &ret);
+        }
+
+        fn wake(self: *Self) !void {
+            if (self.wake_pending.swap(true, .acq_rel)) return;
+
+            const status = napi.napi_call_threadsafe_function(self.tsfn_raw, null, ThreadSafeFunctionMode.NonBlocking.to_raw());
+            if (status != napi.napi_ok) {
+                self.wake_pending.store(false, .release);
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+
+        /// Queues one item. `NonBlocking` fails with `QueueFull` when the
+        /// ring is full; `Blocking` wakes the JS thread and yields until a
+        /// slot frees up. Must not be called on the JS thread with `Blocking`.
+        pub fn push(self: *Self, item: Item, mode: ThreadSafeFunctionMode) !void {
+            while (!self.ring.push(item)) {
+                if (mode == .NonBlocking) {
+                    return NapiError.Error.fromStatus(NapiError.Status.QueueFull);
+                }
+                try self.wake();
+                std.Thread.yield() catch {};
+            }
+
+            const depth = self.pending.fetchAdd(1, .acq_rel) + 1;
+            if (depth >= batch_options.flush_threshold) {
+                try self.wake();
+            } else if (comptime max_delay_ns != 0) {
+                if (depth == 1) {
+                    self.startDelay();
+                } else if (wake_timer.nowNs() -| self.first_pending_ns.load(.acquire) >= max_delay_ns) {
+                    try self.wake();
+                }
+            }
+        }
+
+        /// Delivers pending items below `flush_threshold` without waiting for
+        /// more to arrive.
+        pub fn flush(self: *Self) !void {
+            if (self.pending.load(.acquire) == 0) return;
+            try self.wake();
+        }
+
+        pub fn acquire(self: *const Self) !void {
+            const status = napi.napi_acquire_threadsafe_function(self.tsfn_raw);
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+
+        /// Flushes pending items, then releases this thread's use.
+        pub fn release(self: *Self, mode: ThreadSafeFunctionReleaseMode) !void {
+            if (mode == .Release) self.flush() catch {};
+            const status = napi.napi_release_threadsafe_function(self.tsfn_raw, mode.to_raw());
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+
+        pub fn ref(self: *const Self) !void {
+            const status = napi.napi_ref_threadsafe_function(self.env, self.tsfn_raw);
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+
+        pub fn unref(self: *const Self) !void {
+            const status = napi.napi_unref_threadsafe_function(self.env, self.tsfn_raw);
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+    };
+}
+
+test "Ring preserves order and reports full" {
+    const TestRing = Ring(u32, 4);
+    var ring: TestRing = undefined;
+    ring.init();
+
+    for (0..4) |i| try std.testing.expect(ring.push(@intCast(i)));
+    try std.testing.expect(!ring.push(4));
+
+    for (0..4) |i| try std.testing.expectEqual(@as(?u32, @intCast(i)), ring.pop());
+    try std.testing.expectEqual(@as(?u32, null), ring.pop());
+
+    try std.testing.expect(ring.push(5));
+    try std.testing.expectEqual(@as(?u32, 5), ring.pop());
+}
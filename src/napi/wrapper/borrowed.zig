@@ -0,0 +1,124 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const NapiError = @import("error.zig");
+const options = @import("../options.zig");
+
+/// Byte view over a Buffer, ArrayBuffer or Uint8Array argument.
+///
+/// The slice points directly at the engine's backing store: nothing is copied,
+/// allocated or freed. It is only valid for the duration of the synchronous
+/// call that received it, so copy the bytes before keeping them in class
+/// fields, async descriptors or other state that outlives the call.
+///
+/// On emnapi the slice is a copy in wasm linear memory; call `flush` after
+/// writing through a `[]u8` view so JavaScript sees the bytes.
+pub fn Borrowed(comptime T: type) type {
+    if (T != []const u8 and T != []u8) {
+        @compileError("Borrowed only supports []const u8 or []u8, got: " ++ @typeName(T));
+    }
+
+    return struct {
+        pub const is_napi_borrowed = true;
+        pub const borrowed_type = T;
+
+        env: napi.napi_env,
+        raw: napi.napi_value,
+        bytes: T,
+
+        const Self = @This();
+
+        pub fn from_raw(env: napi.napi_env, raw: napi.napi_value) Self {
+            return Self.from_napi_value(env, raw);
+        }
+
+        pub fn from_napi_value(env: napi.napi_env, raw: napi.napi_value) Self {
+            const bytes = backingBytes(env, raw) orelse {
+                NapiError.last_error = NapiError.Error{ .JsTypeError = NapiError.JsTypeError.fromMessage("Expected a Buffer, ArrayBuffer or Uint8Array") };
+                return Self{ .env = env, .raw = raw, .bytes = emptyBytes() };
+            };
+            return Self{ .env = env, .raw = raw, .bytes = bytes };
+        }
+
+        pub fn matches_napi_value(env: napi.napi_env, raw: napi.napi_value) bool {
+            return backingBytes(env, raw) != null;
+        }
+
+        pub fn slice(self: Self) T {
+            return self.bytes;
+        }
+
+        pub fn length(self: Self) usize {
+            return self.bytes.len;
+        }
+
+        /// Sync wasm-side writes back to the JavaScript bytes when running on emnapi.
+        pub fn flush(self: Self) !void {
+            try self.flushRange(0, self.bytes.len);
+        }
+
+        /// Sync wasm-side writes for a byte range of this view.
+        pub fn flushRange(self: Self, byte_offset: usize, byte_length: usize) !void {
+            if (T == []const u8) {
+                @compileError("Borrowed([]const u8) is read-only; use Borrowed([]u8) to write");
+            }
+            if (comptime !options.isWasmNodeAddon()) return;
+            if (byte_offset > self.bytes.len or byte_length > self.bytes.len - byte_offset) {
+                return NapiError.Error.fromStatus(NapiError.Status.InvalidArg);
+            }
+            if (byte_length == 0) return;
+            var raw = self.raw;
+            const status = napi.emnapi_sync_memory(self.env, false, &raw, byte_offset, byte_length);
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+    };
+}
+
+fn emptyBytes() []u8 {
+    const empty: [*]u8 = &[_]u8{};
+    return empty[0..0];
+}
+
+fn bytesFromRaw(data: ?*anyopaque, len: usize) []u8 {
+    if (len == 0 or data == null) return emptyBytes();
+    const ptr: [*]u8 = @ptrCast(data);
+    return ptr[0..len];
+}
+
+fn backingBytes(env: napi.napi_env, raw: napi.napi_value) ?[]u8 {
+    var is_buffer = false;
+    if (napi.napi_is_buffer(env, raw, &is_buffer) == napi.napi_ok and is_buffer) {
+        var data: ?*anyopaque = null;
+        var len: usize = 0;
+        if (napi.napi_get_buffer_info(env, raw, &data, &len) != napi.napi_ok) return null;
+        return bytesFromRaw(data, len);
+    }
+
+    var is_typedarray = false;
+    if (napi.napi_is_typedarray(env, raw, &is_typedarray) == napi.napi_ok and is_typedarray) {
+        var array_type: napi.napi_typedarray_type = undefined;
+        var len: usize = 0;
+        var data: ?*anyopaque = null;
+        var arraybuffer: napi.napi_value = undefined;
+        var byte_offset: usize = 0;
+        const status = napi.napi_get_typedarray_info(env, raw, &array_type, &len, &data, &arraybuffer, &byte_offset);
+        if (status != napi.napi_ok or array_type != napi.napi_uint8_array) return null;
+        return bytesFromRaw(data, len);
+    }
+
+    var is_arraybuffer = false;
+    if (napi.napi_is_arraybuffer(env, raw, &is_arraybuffer) == napi.napi_ok and is_arraybuffer) {
+        var data: ?*anyopaque = null;
+        var len: usize = 0;
+        if (napi.napi_get_arraybuffer_info(env, raw, &data, &len) != napi.napi_ok) return null;
+        return bytesFromRaw(data, len);
+    }
+
+    return null;
+}
+
+test "Borrowed only accepts byte slices" {
+    try std.testing.expect(Borrowed([]const u8).borrowed_type == []const u8);
+    try std.testing.expect(Borrowed([]u8).is_napi_borrowed);
+}
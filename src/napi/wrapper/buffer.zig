@@ -72,7 +72,7 @@ pub const Buffer = struct {
                 var len: usize = 0;
                 _ = napi.napi_get_buffer_info(env, raw, &data, &len);
 
-                const allocator = GlobalAllocator.globalAllocator();
+                const allocator = GlobalAllocator.conversionAllocator();
                 const buf = allocator.alloc(u8, len) catch @panic("OOM");
                 const src: [*]const u8 = @ptrCast(data);
                 @memcpy(buf, src[0..len]);
@@ -5,8 +5,12 @@ const Napi = @import("../util/napi.zig").Napi;
 const helper = @import("../util/helper.zig");
 const NapiError = @import("./error.zig");
 const GlobalAllocator = @import("../util/allocator.zig");
+const instance_data = @import("../util/instance_data.zig");
+const SlabPool = @import("../util/slab_pool.zig").SlabPool;
+const shared_fields = @import("./shared_fields.zig");
+const FieldStorage = shared_fields.FieldStorage;
 
-pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
+pub fn ClassWrapper(comptime T: type, comptime HasInit: bool, comptime field_storage: FieldStorage) type {
     const type_info = @typeInfo(T);
 
     if (type_info != .@"struct") {
@@ -22,41 +26,185 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
 
     const class_name = comptime helper.shortTypeName(T);
 
+    const shared = field_storage == .shared;
+    if (shared) shared_fields.validate(T);
+
     return struct {
         pub const WrappedType = T;
         pub const HasConstructorInit = HasInit;
+        pub const StoresFields = field_storage;
         env: napi.napi_env,
         raw: napi.napi_value,
         const Self = @This();
-        var cached_constructor_ref: ?napi.napi_ref = null;
+        /// Constructor defined for each env, used by factories and to keep
+        /// repeated exports of the class identical.
+        const ConstructorSlot = instance_data.RefSlot(Self);
         const InstanceData = struct {
-            allocator: std.mem.Allocator,
-            value: T,
-
-            fn create() !*InstanceData {
-                const allocator = GlobalAllocator.globalAllocator();
-                const instance = try allocator.create(InstanceData);
-                instance.* = .{
-                    .allocator = allocator,
-                    .value = undefined,
-                };
-                return instance;
+            /// Shared classes keep `T` in the instance's `ArrayBuffer`.
+            storage: if (shared) SharedStorage else T,
+            /// Allocator that owns memory inside the value. Plain-data classes
+            /// have nothing to free and skip the field.
+            allocator: if (owns_allocations) std.mem.Allocator else void,
+
+            const owns_allocations = !helper.isPlainData(T);
+            const SharedStorage = shared_fields.Storage(T);
+
+            fn value(self: *InstanceData) *T {
+                return if (comptime shared) self.storage.value else &self.storage;
+            }
+
+            /// Points a shared instance at fresh zeroed storage.
+            fn prepare(self: *InstanceData, env: napi.napi_env) !void {
+                if (comptime shared) self.storage = try SharedStorage.create(env);
             }
 
-            fn destroyUninitialized(self: *InstanceData) void {
-                self.allocator.destroy(self);
+            /// Fails when the value of a shared instance can no longer be
+            /// read because its buffer was detached.
+            fn ensureStorage(self: *InstanceData, env: napi.napi_env) !void {
+                if (comptime shared) try self.storage.ensureAttached(env);
             }
 
-            fn destroy(self: *InstanceData) void {
+            fn releaseStorage(self: *InstanceData, env: napi.napi_env) void {
+                if (comptime shared) self.storage.release(env);
+            }
+
+            fn destroy(self: *InstanceData, env: napi.napi_env) void {
+                defer self.releaseStorage(env);
+                if (comptime !owns_allocations) return;
+
                 const previous_allocator = GlobalAllocator.globalAllocator();
                 GlobalAllocator.global_manager.set(self.allocator);
                 defer GlobalAllocator.global_manager.set(previous_allocator);
 
-                Napi.deinit_napi_value(T, self.value);
-                self.allocator.destroy(self);
+                Napi.deinit_napi_value(T, self.value().*);
             }
         };
 
+        /// Instances of one env are carved from a per-env slab pool. The pool
+        /// is closed with the env and freed after its last instance is
+        /// finalized, so finalizers running after env teardown stay valid.
+        const instance_slab_len = 64;
+        const InstancePool = SlabPool(InstanceData, instance_slab_len);
+        const InstancePoolHandle = struct {
+            pool: *InstancePool,
+
+            pub fn deinit(self: *InstancePoolHandle, _: napi.napi_env) void {
+                self.pool.close();
+            }
+        };
+        const InstancePoolSlot = instance_data.Slot(InstancePool, InstancePoolHandle);
+
+        fn instancePool(env: napi.napi_env) !*InstancePool {
+            if (InstancePoolSlot.get(env)) |handle| return handle.pool;
+
+            const pool = try InstancePool.create(GlobalAllocator.runtimeAllocator());
+            errdefer pool.close();
+            const handle = try InstancePoolSlot.put(env, .{ .pool = pool });
+            return handle.pool;
+        }
+
+        /// JS accessors of a shared class, per env. Empty when the engine
+        /// cannot run scripts and the class uses native field accessors.
+        const RegistrarSlot = instance_data.Slot(InstanceData, shared_fields.Registrar);
+
+        /// Gives the JS accessors of `this_obj` a view over its storage.
+        fn attachStorage(env: napi.napi_env, instance: *InstanceData, this_obj: napi.napi_value) !void {
+            if (comptime !shared) return;
+            const registrar = RegistrarSlot.get(env) orelse return;
+            try instance.storage.attach(env, registrar, this_obj);
+        }
+
+        /// Returns an instance whose value was never populated to the pool.
+        fn discardInstance(env: napi.napi_env, pool: *InstancePool, instance: *InstanceData) void {
+            instance.releaseStorage(env);
+            pool.release(instance);
+        }
+
+        /// Wraps `instance` into `this_obj`. The pool travels as the finalize
+        /// hint so the finalizer never has to look up env state.
+        fn wrapInstance(env: napi.napi_env, this_obj: napi.napi_value, pool: *InstancePool, instance: *InstanceData) !void {
+            const status = napi.napi_wrap(env, this_obj, instance, finalize_callback, pool, null);
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+        }
+
+        /// Instance prepared by `New` or a factory method for the constructor
+        /// call it is about to make. The constructor adopts it instead of
+        /// converting arguments, so the built value is never marshaled back
+        /// through JavaScript.
+        const Adoption = struct {
+            pool: *InstancePool,
+            instance: *InstanceData,
+        };
+        threadlocal var pending_adoption: ?Adoption = null;
+
+        /// Moves `value` into a new JS instance of this class. `value` is
+        /// owned by the instance afterwards, including on error.
+        fn newInstance(env: napi.napi_env, value: T) !napi.napi_value {
+            const constructor = ConstructorSlot.get(env) orelse {
+                Napi.deinit_napi_value(T, value);
+                return NapiError.Error.fromReason("Class is not defined in this env");
+            };
+            const pool = instancePool(env) catch |err| {
+                Napi.deinit_napi_value(T, value);
+                return err;
+            };
+            const instance = pool.acquire() catch |err| {
+                Napi.deinit_napi_value(T, value);
+                return err;
+            };
+            instance.prepare(env) catch |err| {
+                pool.release(instance);
+                Napi.deinit_napi_value(T, value);
+                return err;
+            };
+            instance.value().* = value;
+            if (comptime InstanceData.owns_allocations) {
+                instance.allocator = GlobalAllocator.globalAllocator();
+            }
+
+            pending_adoption = .{ .pool = pool, .instance = instance };
+            var js_instance: napi.napi_value = undefined;
+            const status = napi.napi_new_instance(env, constructor, 0, null, &js_instance);
+            if (pending_adoption) |unclaimed| {
+                pending_adoption = null;
+                unclaimed.instance.destroy(env);
+                unclaimed.pool.release(unclaimed.instance);
+            }
+            if (status != napi.napi_ok) {
+                return NapiError.Error.fromStatus(NapiError.Status.New(status));
+            }
+            return js_instance;
+        }
+
+        /// Creates a JS instance that owns `value`, without converting its
+        /// fields. Return the result from an exported function to hand the
+        /// instance to JavaScript.
+        pub fn New(env: napi_env.Env, value: T) !Self {
+            const raw = try newInstance(env.raw, value);
+            return Self{ .env = env.raw, .raw = raw };
+        }
+
+        fn adoptInstance(env: napi.napi_env, callback_info: napi.napi_callback_info, adoption: Adoption) napi.napi_value {
+            var no_args: [0]napi.napi_value = undefined;
+            var this_obj: napi.napi_value = undefined;
+            // Throw on failure: returning a bare `this` would let
+            // `napi_new_instance` succeed with no native data attached.
+            if (readCallbackInfo(0, env, callback_info, &no_args, &this_obj) == null) {
+                adoption.instance.destroy(env);
+                adoption.pool.release(adoption.instance);
+                return throwAnyAndNull(env, NapiError.Error.fromStatus(NapiError.Status.GenericFailure));
+            }
+            wrapInstance(env, this_obj, adoption.pool, adoption.instance) catch |err| {
+                adoption.instance.destroy(env);
+                adoption.pool.release(adoption.instance);
+                return throwAnyAndNull(env, err);
+            };
+            attachStorage(env, adoption.instance, this_obj) catch |err| return throwAnyAndNull(env, err);
+            return this_obj;
+        }
+
         fn readCallbackInfo(
             comptime Argc: usize,
             env: napi.napi_env,
@@ -120,6 +268,11 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
         }
 
         fn constructor_callback(env: napi.napi_env, callback_info: napi.napi_callback_info) callconv(.c) napi.napi_value {
+            if (pending_adoption) |adoption| {
+                pending_adoption = null;
+                return adoptInstance(env, callback_info, adoption);
+            }
+
             const constructor_arg_count = comptime blk: {
                 if (HasInit and @hasDecl(T, "init")) {
                     break :blk @typeInfo(@TypeOf(T.init)).@"fn".params.len;
@@ -130,8 +283,20 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
             var this_obj: napi.napi_value = undefined;
             _ = readCallbackInfo(constructor_arg_count, env, callback_info, &args_raw, &this_obj) orelse return null;
 
-            const instance = InstanceData.create() catch return null;
-            const data = &instance.value;
+            const pool = instancePool(env) catch |err| return throwAnyAndNull(env, err);
+            const instance = pool.acquire() catch |err| return throwAnyAndNull(env, err);
+            instance.prepare(env) catch |err| {
+                pool.release(instance);
+                return throwAnyAndNull(env, err);
+            };
+            if (comptime InstanceData.owns_allocations) {
+                instance.allocator = GlobalAllocator.globalAllocator();
+            }
+            const data = instance.value();
+
+            // Converted arguments move into the instance and live until finalize.
+            var call_scope = GlobalAllocator.CallScope.beginOwned();
+            defer call_scope.end();
 
             if (comptime HasInit and @hasDecl(T, "init")) {
                 const init_fn = T.init;
@@ -144,7 +309,7 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                     const converted = Napi.from_napi_value_auto(env, args_raw[i], arg.type.?);
                     if (NapiError.last_error) |last_err| {
                         last_err.throwInto(napi_env.Env.from_raw(env));
-                        instance.destroyUninitialized();
+                        discardInstance(env, pool, instance);
                         return null;
                     }
                     tuple_args[i] = converted;
@@ -153,36 +318,37 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                 const init_result = if (@typeInfo(init_fn_info.@"fn".return_type.?) == .error_union)
                     @call(.auto, init_fn, tuple_args) catch |err| {
                         NapiError.mapAnyError(err).throwInto(napi_env.Env.from_raw(env));
-                        instance.destroyUninitialized();
+                        discardInstance(env, pool, instance);
                         return null;
                     }
                 else
                     @call(.auto, init_fn, tuple_args);
                 data.* = factoryValueFromResult(env, init_result) orelse {
-                    instance.destroyUninitialized();
+                    discardInstance(env, pool, instance);
                     return null;
                 };
+            } else if (comptime !HasInit) {
+                // Shared storage starts zeroed.
+                if (comptime !shared) data.* = std.mem.zeroes(T);
             } else {
-                data.* = std.mem.zeroes(T);
-                if (comptime HasInit) {
-                    inline for (fields, 0..) |field, i| {
-                        NapiError.clearLastError();
-                        const converted = Napi.from_napi_value_auto(env, args_raw[i], field.type);
-                        if (NapiError.last_error) |last_err| {
-                            last_err.throwInto(napi_env.Env.from_raw(env));
-                            instance.destroyUninitialized();
-                            return null;
-                        }
-                        @field(data.*, field.name) = converted;
+                inline for (fields, 0..) |field, i| {
+                    NapiError.clearLastError();
+                    const converted = Napi.from_napi_value_auto(env, args_raw[i], field.type);
+                    if (NapiError.last_error) |last_err| {
+                        last_err.throwInto(napi_env.Env.from_raw(env));
+                        discardInstance(env, pool, instance);
+                        return null;
                     }
+                    @field(data.*, field.name) = converted;
                 }
             }
 
-            const status = napi.napi_wrap(env, this_obj, instance, finalize_callback, null, null);
-            if (status != napi.napi_ok) {
-                instance.destroy();
-                return null;
-            }
+            wrapInstance(env, this_obj, pool, instance) catch |err| {
+                instance.destroy(env);
+                pool.release(instance);
+                return throwAnyAndNull(env, err);
+            };
+            attachStorage(env, instance, this_obj) catch |err| return throwAnyAndNull(env, err);
 
             return this_obj;
         }
@@ -201,6 +367,9 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
 
                     var instance_data: T = undefined;
 
+                    var call_scope = GlobalAllocator.CallScope.beginOwned();
+                    defer call_scope.end();
+
                     if (params.len == 0) {
                         const factory_result = if (@typeInfo(factory_fn_info.@"fn".return_type.?) == .error_union)
                             factory_fn() catch |err| {
@@ -231,40 +400,17 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                         }
                     }
 
-                    const class_constructor_ref = Self.cached_constructor_ref orelse return null;
-                    defer Napi.deinit_napi_value(T, instance_data);
-
-                    var constructor_args: [fields.len]napi.napi_value = undefined;
-                    inline for (fields, 0..) |field, i| {
-                        constructor_args[i] = Napi.to_napi_value_auto(env, @field(instance_data, field.name), field.name) catch return null;
-                    }
-
-                    var constructor: napi.napi_value = undefined;
-                    const get_ref_status = napi.napi_get_reference_value(env, class_constructor_ref, &constructor);
-                    if (get_ref_status != napi.napi_ok) return null;
-
-                    var js_instance: napi.napi_value = undefined;
-                    const status = napi.napi_new_instance(
-                        env,
-                        constructor,
-                        fields.len,
-                        if (fields.len == 0) null else @ptrCast(&constructor_args),
-                        &js_instance,
-                    );
-                    if (status != napi.napi_ok) return null;
-
-                    return js_instance;
+                    return newInstance(env, instance_data) catch |err| throwAnyAndNull(env, err);
                 }
             };
         }
 
         fn finalize_callback(env: napi.napi_env, data: ?*anyopaque, hint: ?*anyopaque) callconv(.c) void {
-            _ = env;
-            _ = hint;
-
             if (data) |ptr| {
                 const instance: *InstanceData = @ptrCast(@alignCast(ptr));
-                instance.destroy();
+                const pool: *InstancePool = @ptrCast(@alignCast(hint.?));
+                instance.destroy(env);
+                pool.release(instance);
             }
         }
 
@@ -289,6 +435,20 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
         }
 
         fn define_class(env: napi.napi_env) !napi.napi_value {
+            if (ConstructorSlot.get(env)) |constructor| return constructor;
+
+            // Shared classes reuse the accessors already installed in this
+            // env, or compile new ones. Without script support their fields
+            // fall back to native accessors.
+            const registrar: ?*shared_fields.Registrar = if (comptime shared) RegistrarSlot.get(env) else null;
+            const installer: ?napi.napi_value = if (comptime !shared)
+                null
+            else if (registrar == null)
+                shared_fields.compileInstaller(env, T)
+            else
+                null;
+            const native_accessors = !shared or (registrar == null and installer == null);
+
             // Count instance properties and methods
             comptime var property_count: usize = fields.len;
 
@@ -313,7 +473,7 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
             var prop_idx: usize = 0;
 
             // Process instance fields
-            inline for (fields) |field| {
+            if (native_accessors) inline for (fields) |field| {
                 const FieldAccessor = struct {
                     fn getter(getter_env: napi.napi_env, info: napi.napi_callback_info) callconv(.c) napi.napi_value {
                         var args_raw: [0]napi.napi_value = undefined;
@@ -325,7 +485,8 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                         if (data == null) return null;
 
                         const instance: *InstanceData = @ptrCast(@alignCast(data.?));
-                        const field_value = @field(instance.value, field.name);
+                        instance.ensureStorage(getter_env) catch |err| return throwAnyAndNull(getter_env, err);
+                        const field_value = @field(instance.value().*, field.name);
                         return Napi.to_napi_value_auto(getter_env, field_value, field.name) catch null;
                     }
 
@@ -339,14 +500,18 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                         if (data == null) return null;
 
                         const instance: *InstanceData = @ptrCast(@alignCast(data.?));
+                        instance.ensureStorage(setter_env) catch |err| return throwAnyAndNull(setter_env, err);
                         if (actual_argc > 0) {
+                            var call_scope = GlobalAllocator.CallScope.beginOwned();
+                            defer call_scope.end();
+
                             NapiError.clearLastError();
                             const new_value = Napi.from_napi_value_auto(setter_env, args_raw[0], field.type);
                             if (NapiError.last_error) |last_err| {
                                 last_err.throwInto(napi_env.Env.from_raw(setter_env));
                                 return null;
                             }
-                            @field(instance.value, field.name) = new_value;
+                            @field(instance.value().*, field.name) = new_value;
                         }
                         return null;
                     }
@@ -371,23 +536,8 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                 if (comptime isConstDecl(decl.name)) {
                     const const_value = @field(T, decl.name);
 
-                    // Create a static value property descriptor
-                    // The value is converted at define_class time
-                    const StaticValueHolder = struct {
-                        var cached_value: ?napi.napi_value = null;
-
-                        fn getValue(holder_env: napi.napi_env) napi.napi_value {
-                            if (cached_value) |val| {
-                                return val;
-                            }
-                            const val = Napi.to_napi_value_auto(holder_env, const_value, decl.name) catch return null;
-                            cached_value = val;
-                            return val;
-                        }
-                    };
-
-                    // Get the static value
-                    const static_value = StaticValueHolder.getValue(env);
+                    // The value is converted once per env, when the class is defined
+                    const static_value = try Napi.to_napi_value_auto(env, const_value, decl.name);
 
                     properties[prop_idx] = napi.napi_property_descriptor{
                         .utf8name = @ptrCast(decl.name.ptr),
@@ -439,6 +589,13 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                             };
                         } else {
                             const MethodWrapper = struct {
+                                const uses_call_arena = blk: {
+                                    for (params[method_args_offset..]) |param| {
+                                        if (!Napi.canUseCallArena(param.type.?)) break :blk false;
+                                    }
+                                    break :blk true;
+                                };
+
                                 fn cleanupArgs(args: *std.meta.ArgsTuple(@TypeOf(method)), initialized: usize) void {
                                     inline for (method_info.@"fn".params[method_args_offset..], method_args_offset..) |param, i| {
                                         if (i < initialized) {
@@ -456,10 +613,20 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                                     var data: ?*anyopaque = null;
                                     _ = napi.napi_unwrap(method_env, this_obj, &data);
                                     if (data == null) return null;
+                                    if (comptime is_instance_method) {
+                                        const instance: *InstanceData = @ptrCast(@alignCast(data.?));
+                                        instance.ensureStorage(method_env) catch |err| return throwAnyAndNull(method_env, err);
+                                    }
+
+                                    var call_scope = if (comptime uses_call_arena)
+                                        GlobalAllocator.CallScope.begin()
+                                    else
+                                        GlobalAllocator.CallScope.beginOwned();
+                                    defer call_scope.end();
 
                                     var tuple_args: std.meta.ArgsTuple(@TypeOf(method)) = undefined;
                                     var initialized_args: usize = 0;
-                                    defer cleanupArgs(&tuple_args, initialized_args);
+                                    defer if (comptime !uses_call_arena) cleanupArgs(&tuple_args, initialized_args);
 
                                     // inject instance
                                     if (is_instance_method) {
@@ -467,7 +634,7 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                                             @compileError("Method " ++ fn_name ++ " must have a self parameter, which is a pointer to the class");
                                         }
                                         const instance: *InstanceData = @ptrCast(@alignCast(data.?));
-                                        tuple_args[0] = &instance.value;
+                                        tuple_args[0] = instance.value();
                                         initialized_args = 1;
                                     }
 
@@ -482,6 +649,7 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                                         tuple_args[i] = converted;
                                         initialized_args = i + 1;
                                     }
+                                    call_scope.endConversion();
                                     if (@typeInfo(return_type) == .error_union) {
                                         const result = @call(.auto, method, tuple_args) catch |err| {
                                             return throwAnyAndNull(method_env, err);
@@ -515,13 +683,19 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
                 return NapiError.Error.fromStatus(NapiError.Status.New(define_status));
             }
 
-            var new_constructor_ref: napi.napi_ref = undefined;
-            const ref_status = napi.napi_create_reference(env, constructor, 1, &new_constructor_ref);
-            if (ref_status != napi.napi_ok) {
-                return NapiError.Error.fromStatus(NapiError.Status.New(ref_status));
+            if (comptime shared) {
+                if (registrar) |existing| {
+                    try existing.installOn(env, constructor);
+                } else if (installer) |function| {
+                    var created = try shared_fields.Registrar.create(env, function, constructor);
+                    errdefer created.deinit(env);
+                    _ = try RegistrarSlot.put(env, created);
+                }
             }
 
-            Self.cached_constructor_ref = new_constructor_ref;
+            // Without the cached constructor the class still works; only
+            // `New` and factory methods need it.
+            ConstructorSlot.remember(env, constructor);
             return constructor;
         }
 
@@ -536,11 +710,17 @@ pub fn ClassWrapper(comptime T: type, comptime HasInit: bool) type {
 }
 
 pub fn Class(comptime T: type) type {
-    return ClassWrapper(T, true);
+    return ClassWrapper(T, true, .native);
 }
 
 pub fn ClassWithoutInit(comptime T: type) type {
-    return ClassWrapper(T, false);
+    return ClassWrapper(T, false, .native);
+}
+
+/// Class whose numeric fields live in an `ArrayBuffer` shared with JS, so
+/// field reads and writes from JS never call into native code.
+pub fn SharedClass(comptime T: type) type {
+    return ClassWrapper(T, true, .shared);
 }
 
 pub fn isClass(T: anytype) bool {
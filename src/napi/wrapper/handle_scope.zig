@@ -0,0 +1,123 @@
+const std = @import("std");
+const napi = @import("napi-sys").napi_sys;
+const Env = @import("../env.zig").Env;
+const NapiError = @import("./error.zig");
+
+/// Releases every handle created while it is open. Values created inside the
+/// scope must not be used after `close`.
+pub const HandleScope = struct {
+    env: napi.napi_env,
+    raw: napi.napi_handle_scope,
+
+    pub fn open(env: Env) !HandleScope {
+        var raw: napi.napi_handle_scope = null;
+        const status = napi.napi_open_handle_scope(env.raw, &raw);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+        return HandleScope{ .env = env.raw, .raw = raw };
+    }
+
+    pub fn close(self: HandleScope) !void {
+        const status = napi.napi_close_handle_scope(self.env, self.raw);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+    }
+};
+
+/// Handle scope that can promote one value to the enclosing scope.
+pub const EscapableHandleScope = struct {
+    env: napi.napi_env,
+    raw: napi.napi_escapable_handle_scope,
+
+    pub fn open(env: Env) !EscapableHandleScope {
+        var raw: napi.napi_escapable_handle_scope = null;
+        const status = napi.napi_open_escapable_handle_scope(env.raw, &raw);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+        return EscapableHandleScope{ .env = env.raw, .raw = raw };
+    }
+
+    /// Returns `value` re-created in the enclosing scope. `value` may be a raw
+    /// `napi_value` or any wrapper with `from_raw` and a `raw` field.
+    pub fn escape(self: EscapableHandleScope, value: anytype) !@TypeOf(value) {
+        const T = @TypeOf(value);
+        const raw = if (T == napi.napi_value) value else value.raw;
+
+        var escaped: napi.napi_value = undefined;
+        const status = napi.napi_escape_handle(self.env, self.raw, raw, &escaped);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+
+        if (T == napi.napi_value) return escaped;
+        var result = value;
+        result.raw = escaped;
+        return result;
+    }
+
+    pub fn close(self: EscapableHandleScope) !void {
+        const status = napi.napi_close_escapable_handle_scope(self.env, self.raw);
+        if (status != napi.napi_ok) {
+            return NapiError.Error.fromStatus(NapiError.Status.New(status));
+        }
+    }
+};
+
+/// Number of elements a built-in conversion loop handles before it recycles
+/// its handle scope.
+pub const element_scope_interval = 1024;
+
+/// Bounds handle usage of element loops. The first `element_scope_interval`
+/// elements use the caller's scope, so short loops never open one; after
+/// that, handles are released every `element_scope_interval` elements.
+///
+/// Only use it when the loop body keeps no `napi_value` past the current
+/// element.
+pub const ElementScope = struct {
+    env: napi.napi_env,
+    raw: napi.napi_handle_scope = null,
+    count: usize = 0,
+
+    /// A null `env` gives a scope that never opens, for loops whose elements
+    /// must stay valid.
+    pub fn begin(env: napi.napi_env) ElementScope {
+        return .{ .env = env };
+    }
+
+    /// Call before converting each element.
+    pub fn next(self: *ElementScope) void {
+        if (self.env == null) return;
+        self.count += 1;
+        if (self.count < element_scope_interval) return;
+        self.count = 0;
+
+        if (self.raw != null) {
+            _ = napi.napi_close_handle_scope(self.env, self.raw);
+            self.raw = null;
+        }
+        var raw: napi.napi_handle_scope = null;
+        if (napi.napi_open_handle_scope(self.env, &raw) == napi.napi_ok) {
+            self.raw = raw;
+        }
+    }
+
+    pub fn end(self: *ElementScope) void {
+        if (self.raw != null) {
+            _ = napi.napi_close_handle_scope(self.env, self.raw);
+            self.raw = null;
+        }
+    }
+};
+
+test "ElementScope without an env never opens a scope" {
+    var scope = ElementScope.begin(null);
+    for (0..element_scope_interval * 3) |_| {
+        scope.next();
+    }
+    try std.testing.expect(scope.raw == null);
+    try std.testing.expect(scope.count == 0);
+    scope.end();
+}
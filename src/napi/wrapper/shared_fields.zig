@@ -0,0 +1,213 @@
+const std = @import("std");
+const builtin = @import("builtin");
+const napi = @import("napi-sys").napi_sys;
+const NapiError = @import("./error.zig");
+
+/// How a field is stored in a shared-field class.
+pub const FieldStorage = enum {
+    /// Fields live in native memory and JS accessors call into native code.
+    native,
+    /// The whole struct lives in an `ArrayBuffer` owned by the instance. JS
+    /// accessors read and write it through a `DataView`; Zig methods see the
+    /// same bytes through `*T`.
+    shared,
+};
+
+/// Name of the `DataView` accessor pair for a field type.
+fn viewAccessor(comptime F: type) []const u8 {
+    return switch (@typeInfo(F)) {
+        .bool => "Uint8",
+        .float => |float| switch (float.bits) {
+            32 => "Float32",
+            64 => "Float64",
+            else => @compileError("Shared class fields support f32 and f64, got: " ++ @typeName(F)),
+        },
+        .int => |int| switch (int.bits) {
+            8, 16, 32 => (if (int.signedness == .signed) "Int" else "Uint") ++ std.fmt.comptimePrint("{d}", .{int.bits}),
+            else => @compileError("Shared class fields support integers up to 32 bits, got: " ++ @typeName(F)),
+        },
+        else => @compileError("Shared class fields must be numbers or bools, got: " ++ @typeName(F)),
+    };
+}
+
+/// Checks at compile time that every field of `T` can be shared with JS.
+pub fn validate(comptime T: type) void {
+    const info = @typeInfo(T).@"struct";
+    if (info.fields.len == 0) {
+        @compileError("SharedClass() needs at least one field: " ++ @typeName(T));
+    }
+    if (@hasDecl(T, "deinit")) {
+        @compileError("SharedClass() fields own no memory, so " ++ @typeName(T) ++ " must not declare deinit");
+    }
+    for (info.fields) |field| {
+        _ = viewAccessor(field.type);
+    }
+}
+
+/// Source of a script that evaluates to the accessor installer for `T`.
+/// The installer defines `DataView`-backed accessors on a prototype and
+/// returns the function that registers an instance's view. Views live in a
+/// `WeakMap` captured by both closures, so JS code never sees the view or
+/// its buffer.
+fn installerSource(comptime T: type) [:0]const u8 {
+    return comptime blk: {
+        @setEvalBranchQuota(10_000 + @typeInfo(T).@"struct".fields.len * 1_000);
+        const little_endian = if (builtin.cpu.arch.endian() == .little) "true" else "false";
+        var source: []const u8 = "(function () {\n" ++
+            "  const views = new WeakMap();\n" ++
+            "  function register(target, view) { views.set(target, view); }\n" ++
+            "  return function (proto) {\n" ++
+            "    Object.defineProperties(proto, {\n";
+        for (@typeInfo(T).@"struct".fields) |field| {
+            const accessor = viewAccessor(field.type);
+            const offset = std.fmt.comptimePrint("{d}", .{@offsetOf(T, field.name)});
+            const endian = if (@sizeOf(field.type) > 1) ", " ++ little_endian else "";
+            const read = "views.get(this).get" ++ accessor ++ "(" ++ offset ++ endian ++ ")";
+            const getter = if (field.type == bool) read ++ " !== 0" else read;
+            const stored = if (field.type == bool) "v ? 1 : 0" else "v";
+            source = source ++ "      \"" ++ field.name ++ "\": {\n" ++
+                "        get() { return " ++ getter ++ "; },\n" ++
+                "        set(v) { views.get(this).set" ++ accessor ++ "(" ++ offset ++ ", " ++ stored ++ endian ++ "); },\n" ++
+                "      },\n";
+        }
+        source = source ++ "    });\n    return register;\n  };\n})()";
+        break :blk std.fmt.comptimePrint("{s}", .{source});
+    };
+}
+
+fn check(status: napi.napi_status) !void {
+    if (status != napi.napi_ok) {
+        return NapiError.Error.fromStatus(NapiError.Status.New(status));
+    }
+}
+
+fn callFunction(env: napi.napi_env, function: napi.napi_value, args: []const napi.napi_value) !napi.napi_value {
+    var receiver: napi.napi_value = undefined;
+    try check(napi.napi_get_undefined(env, &receiver));
+
+    var result: napi.napi_value = undefined;
+    try check(napi.napi_call_function(env, receiver, function, args.len, args.ptr, &result));
+    return result;
+}
+
+/// Evaluates the accessor installer for `T`. Returns null when the engine
+/// cannot run scripts; the class then defines native field accessors.
+pub fn compileInstaller(env: napi.napi_env, comptime T: type) ?napi.napi_value {
+    const source_text = comptime installerSource(T);
+
+    var source: napi.napi_value = undefined;
+    if (napi.napi_create_string_utf8(env, source_text.ptr, source_text.len, &source) != napi.napi_ok) return null;
+
+    var installer: napi.napi_value = undefined;
+    if (napi.napi_run_script(env, source, &installer) != napi.napi_ok) {
+        var pending = false;
+        if (napi.napi_is_exception_pending(env, &pending) == napi.napi_ok and pending) {
+            var ignored: napi.napi_value = undefined;
+            _ = napi.napi_get_and_clear_last_exception(env, &ignored);
+        }
+        return null;
+    }
+    return installer;
+}
+
+/// JS side of a shared class in one env: the installer and the register
+/// function it returned, both held through strong references.
+pub const Registrar = struct {
+    installer: napi.napi_ref,
+    register: napi.napi_ref,
+
+    /// Installs the accessors on the prototype of `constructor` and keeps
+    /// the installer for later definitions of the class.
+    pub fn create(env: napi.napi_env, installer: napi.napi_value, constructor: napi.napi_value) !Registrar {
+        const register = try installOnPrototype(env, installer, constructor);
+
+        var installer_ref: napi.napi_ref = null;
+        try check(napi.napi_create_reference(env, installer, 1, &installer_ref));
+        errdefer _ = napi.napi_delete_reference(env, installer_ref);
+
+        var register_ref: napi.napi_ref = null;
+        try check(napi.napi_create_reference(env, register, 1, &register_ref));
+        return .{ .installer = installer_ref, .register = register_ref };
+    }
+
+    pub fn deinit(self: *Registrar, env: napi.napi_env) void {
+        _ = napi.napi_delete_reference(env, self.installer);
+        _ = napi.napi_delete_reference(env, self.register);
+    }
+
+    /// Installs the same accessors on the prototype of another definition
+    /// of the class in this env.
+    pub fn installOn(self: *const Registrar, env: napi.napi_env, constructor: napi.napi_value) !void {
+        var installer: napi.napi_value = undefined;
+        try check(napi.napi_get_reference_value(env, self.installer, &installer));
+        _ = try installOnPrototype(env, installer, constructor);
+    }
+
+    fn installOnPrototype(env: napi.napi_env, installer: napi.napi_value, constructor: napi.napi_value) !napi.napi_value {
+        var prototype: napi.napi_value = undefined;
+        try check(napi.napi_get_named_property(env, constructor, "prototype", &prototype));
+        return callFunction(env, installer, &.{prototype});
+    }
+};
+
+/// Field storage of one instance: the `ArrayBuffer` and the `T` inside it.
+pub fn Storage(comptime T: type) type {
+    return struct {
+        /// Strong reference that keeps the buffer alive while `value` points
+        /// into it. The instance deletes it when it is finalized.
+        buffer: napi.napi_ref,
+        value: *T,
+
+        /// Allocates zeroed storage for one `T` in a new `ArrayBuffer`.
+        pub fn create(env: napi.napi_env) !@This() {
+            var data: ?*anyopaque = null;
+            var buffer: napi.napi_value = undefined;
+            try check(napi.napi_create_arraybuffer(env, @sizeOf(T), &data, &buffer));
+
+            var ref: napi.napi_ref = null;
+            try check(napi.napi_create_reference(env, buffer, 1, &ref));
+            return .{ .buffer = ref, .value = @ptrCast(@alignCast(data.?)) };
+        }
+
+        pub fn release(self: @This(), env: napi.napi_env) void {
+            _ = napi.napi_delete_reference(env, self.buffer);
+        }
+
+        /// Fails when the buffer was detached, so `value` must not be read.
+        pub fn ensureAttached(self: @This(), env: napi.napi_env) !void {
+            var buffer: napi.napi_value = undefined;
+            try check(napi.napi_get_reference_value(env, self.buffer, &buffer));
+            var detached = false;
+            try check(napi.napi_is_detached_arraybuffer(env, buffer, &detached));
+            if (detached) return NapiError.Error.fromReason("Shared class storage was detached");
+        }
+
+        /// Hands a view over the storage to the JS accessors of `this_obj`.
+        pub fn attach(self: @This(), env: napi.napi_env, registrar: *const Registrar, this_obj: napi.napi_value) !void {
+            var buffer: napi.napi_value = undefined;
+            try check(napi.napi_get_reference_value(env, self.buffer, &buffer));
+
+            var view: napi.napi_value = undefined;
+            try check(napi.napi_create_dataview(env, @sizeOf(T), buffer, 0, &view));
+
+            var register: napi.napi_value = undefined;
+            try check(napi.napi_get_reference_value(env, registrar.register, &register));
+            _ = try callFunction(env, register, &.{ this_obj, view });
+        }
+    };
+}
+
+test "installerSource reads fields at their offsets" {
+    const Point = extern struct {
+        x: f64,
+        y: f64,
+        id: u16,
+        visible: bool,
+    };
+    const source = installerSource(Point);
+    try std.testing.expect(std.mem.indexOf(u8, source, "views.get(this).getFloat64(8, ") != null);
+    try std.testing.expect(std.mem.indexOf(u8, source, "views.get(this).getUint16(16, ") != null);
+    try std.testing.expect(std.mem.indexOf(u8, source, "views.get(this).getUint8(18) !== 0") != null);
+    try std.testing.expect(std.mem.indexOf(u8, source, "views.get(this).setUint8(18, v ? 1 : 0)") != null);
+    try std.testing.expect(std.mem.indexOf(u8, source, "this[") == null);
+}
@@ -8,6 +8,7 @@ const NapiError = @import("./error.zig");
 const String = @import("../value/string.zig").String;
 const GlobalAllocator = @import("../util/allocator.zig");
 const options = @import("../options.zig");
+const function_cache = @import("../util/function_cache.zig");
 
 const ThreadSafeFunctionCallModeRaw = if (options.selectedNapiVersion().isAtLeast(.v4))
     napi.napi_threadsafe_function_call_mode
@@ -54,10 +55,76 @@ pub const ThreadSafeFunctionCallVariant = enum {
     WithCallback,
 };
 
+/// Point-in-time counters of a thread-safe function. Plain numbers, so a
+/// snapshot can be returned to JavaScript as an object.
+pub const ThreadSafeFunctionStats = struct {
+    /// Calls accepted by the queue.
+    enqueued: u64 = 0,
+    /// Calls that reached the JavaScript callback.
+    delivered: u64 = 0,
+    /// Calls rejected by the queue or discarded during teardown.
+    dropped: u64 = 0,
+    /// Calls queued and not yet delivered.
+    depth: u64 = 0,
+    /// Highest `depth` observed.
+    max_depth: u64 = 0,
+    /// Sum and maximum of enqueue-to-delivery latency.
+    total_latency_ns: u64 = 0,
+    max_latency_ns: u64 = 0,
+};
+
+/// Watermarks for producer backpressure. Once the queue depth reaches
+/// `high_watermark`, the function is backpressured until delivery drains
+/// it to `low_watermark`.
+pub const ThreadSafeFunctionBackpressure = struct {
+    high_watermark: usize,
+    low_watermark: usize,
+    /// Runtime that `reserve()` waits on and that the JavaScript thread uses
+    /// to wake waiters.
+    io: std.Io,
+    context: ?*anyopaque = null,
+    /// Runs on the producer thread whose call reached the high watermark.
+    on_high: ?*const fn (context: ?*anyopaque, depth: usize) void = null,
+    /// Runs on the JavaScript thread once the queue drained to the low
+    /// watermark.
+    on_low: ?*const fn (context: ?*anyopaque, depth: usize) void = null,
+};
+
+const Counters = struct {
+    enqueued: std.atomic.Value(u64) = .init(0),
+    delivered: std.atomic.Value(u64) = .init(0),
+    dropped: std.atomic.Value(u64) = .init(0),
+    depth: std.atomic.Value(u64) = .init(0),
+    max_depth: std.atomic.Value(u64) = .init(0),
+    total_latency_ns: std.atomic.Value(u64) = .init(0),
+    max_latency_ns: std.atomic.Value(u64) = .init(0),
+
+    fn snapshot(self: *const Counters) ThreadSafeFunctionStats {
+        return .{
+            .enqueued = self.enqueued.load(.monotonic),
+            .delivered = self.delivered.load(.monotonic),
+            .dropped = self.dropped.load(.monotonic),
+            .depth = self.depth.load(.monotonic),
+            .max_depth = self.max_depth.load(.monotonic),
+            .total_latency_ns = self.total_latency_ns.load(.monotonic),
+            .max_latency_ns = self.max_latency_ns.load(.monotonic),
+        };
+    }
+};
+
+/// Monotonic clock reading used to time queued calls.
+fn nowNs() u64 {
+    const io = std.Io.Threaded.global_single_threaded.io();
+    const reading = std.Io.Clock.awake.now(io);
+    const timestamp = if (comptime @typeInfo(@TypeOf(reading)) == .error_union) reading catch return 0 else reading;
+    return @intCast(@max(timestamp.nanoseconds, 0));
+}
+
 fn CallData(comptime Args: type) type {
     return struct {
         args: ?*Args,
         err: ?*NapiError.Error,
+        enqueued_at: u64,
     };
 }
 
@@ -73,16 +140,57 @@ pub fn ThreadSafeFunction(comptime Args: type, comptime Return: type, comptime T
         return_type: Return,
         closed: bool,
         aborted: bool,
+        counters: Counters = .{},
+        backpressure: ThreadSafeFunctionBackpressure = undefined,
+        /// Set once `backpressure` is written; producers read the config only
+        /// after seeing it.
+        backpressure_set: std.atomic.Value(bool) = .init(false),
+        backpressured: std.atomic.Value(bool) = .init(false),
+        reserve_mutex: std.Io.Mutex = .init,
+        reserve_cond: std.Io.Condition = .init,
+        cache: ?*function_cache.FunctionCache = null,
         comptime thread_safe_function_call_variant: bool = ThreadSafeFunctionCalleeHandled,
         comptime max_queue_size: usize = MaxQueueSize,
 
         const Self = @This();
 
+        /// Marks this instantiation in the per-function cache.
+        var cache_key: u8 = 0;
+
+        /// Returns the thread-safe function for the JS function `raw`, with
+        /// one thread use owned by the caller and given back with `release`.
+        ///
+        /// Instances are cached on the JS function, so converting the same
+        /// callback again acquires the existing instance instead of creating
+        /// a new one. The instance is finalized once every use is released.
+        ///
+        /// Every holder therefore shares one queue: `abort` closes it for all
+        /// of them, `stats` counts their calls together, and watermarks set
+        /// by one holder apply to all.
         pub fn from_raw(env: napi.napi_env, raw: napi.napi_value) *Self {
+            if (function_cache.lookup(env, raw, &cache_key)) |cached| {
+                const self: *Self = @ptrCast(@alignCast(cached));
+                if (!self.aborted) {
+                    if (self.acquire()) |_| return self else |_| {}
+                }
+            }
+
+            const self = create(env, raw);
+            self.cache = function_cache.remember(env, raw, &cache_key, self, detachCache);
+            return self;
+        }
+
+        fn detachCache(ptr: *anyopaque) void {
+            const self: *Self = @ptrCast(@alignCast(ptr));
+            self.cache = null;
+        }
+
+        fn create(env: napi.napi_env, raw: napi.napi_value) *Self {
             const ThreadSafe = struct {
                 fn finalize(_: napi.napi_env, data: ?*anyopaque, _: ?*anyopaque) callconv(.c) void {
                     const self: *Self = @ptrCast(@alignCast(data));
                     self.closed = true;
+                    if (self.cache) |cache| cache.forget(self);
                     self.deinit();
                 }
 
@@ -91,6 +199,15 @@ pub fn ThreadSafeFunction(comptime Args: type, comptime Return: type, comptime T
                     const args: *CallData(Args) = @ptrCast(@alignCast(data));
                     const allocator = self.allocator;
 
+                    // The queue is being torn down without a JS callback.
+                    if (inner_env == null or js_callback == null) {
+                        self.recordDequeued(args.enqueued_at, false);
+                        self.freeCallData(args);
+                        return;
+                    }
+                    const enqueued_at = args.enqueued_at;
+                    defer self.recordDequeued(enqueued_at, true);
+
                     const args_len = if (@typeInfo(Args) == .@"struct" and @typeInfo(Args).@"struct".is_tuple) @typeInfo(Args).@"struct".fields.len else 1;
                     const call_variant = if (self.thread_safe_function_call_variant) 1 else 0;
 
@@ -183,12 +300,107 @@ pub fn ThreadSafeFunction(comptime Args: type, comptime Return: type, comptime T
             self.allocator.destroy(data);
         }
 
-        fn callThreadSafeFunction(self: *const Self, data: *CallData(Args), mode: ThreadSafeFunctionMode) !void {
+        fn callThreadSafeFunction(self: *Self, data: *CallData(Args), mode: ThreadSafeFunctionMode) !void {
+            // Count the call before queueing it, so the JS thread never sees
+            // a delivery ahead of its enqueue.
+            const depth = self.counters.depth.fetchAdd(1, .acq_rel) + 1;
+            data.enqueued_at = nowNs();
+
+            // Raise the flag before queueing. The call queued below is then
+            // dequeued after the flag is visible, and that dequeue clears it
+            // once the depth is low again.
+            const config = self.backpressureConfig();
+            if (config) |active| {
+                if (depth >= active.high_watermark) {
+                    self.raiseBackpressure(active, depth);
+                }
+            }
+
             const status = napi.napi_call_threadsafe_function(self.tsfn_raw, @ptrCast(data), mode.to_raw());
             if (status != napi.napi_ok) {
+                const remaining = self.counters.depth.fetchSub(1, .acq_rel) - 1;
+                _ = self.counters.dropped.fetchAdd(1, .monotonic);
                 self.freeCallData(data);
+                // No dequeue follows a failed call, so clear the flag here.
+                if (config) |active| self.lowerBackpressure(active, remaining);
                 return NapiError.Error.fromStatus(NapiError.Status.New(status));
             }
+
+            _ = self.counters.enqueued.fetchAdd(1, .monotonic);
+            _ = self.counters.max_depth.fetchMax(depth, .monotonic);
+        }
+
+        fn backpressureConfig(self: *const Self) ?ThreadSafeFunctionBackpressure {
+            if (!self.backpressure_set.load(.acquire)) return null;
+            return self.backpressure;
+        }
+
+        fn raiseBackpressure(self: *Self, config: ThreadSafeFunctionBackpressure, depth: usize) void {
+            self.reserve_mutex.lockUncancelable(config.io);
+            defer self.reserve_mutex.unlock(config.io);
+            if (self.backpressured.swap(true, .acq_rel)) return;
+            if (config.on_high) |on_high| on_high(config.context, depth);
+        }
+
+        /// Clears the flag and releases waiters once `depth` is at the low
+        /// watermark.
+        fn lowerBackpressure(self: *Self, config: ThreadSafeFunctionBackpressure, depth: usize) void {
+            if (depth > config.low_watermark or !self.backpressured.load(.acquire)) return;
+
+            self.reserve_mutex.lockUncancelable(config.io);
+            defer self.reserve_mutex.unlock(config.io);
+            if (!self.backpressured.swap(false, .acq_rel)) return;
+            if (config.on_low) |on_low| on_low(config.context, depth);
+            self.reserve_cond.broadcast(config.io);
+        }
+
+        /// Runs on the JavaScript thread for every call taken off the queue.
+        fn recordDequeued(self: *Self, enqueued_at: u64, delivered: bool) void {
+            const depth = self.counters.depth.fetchSub(1, .acq_rel) - 1;
+            if (delivered) {
+                const latency = nowNs() -| enqueued_at;
+                _ = self.counters.delivered.fetchAdd(1, .monotonic);
+                _ = self.counters.total_latency_ns.fetchAdd(latency, .monotonic);
+                _ = self.counters.max_latency_ns.fetchMax(latency, .monotonic);
+            } else {
+                _ = self.counters.dropped.fetchAdd(1, .monotonic);
+            }
+
+            const config = self.backpressureConfig() orelse return;
+            self.lowerBackpressure(config, depth);
+        }
+
+        /// Enables watermarks. Call on the JavaScript thread before producers
+        /// start. Every conversion of the same JS function shares this
+        /// instance, so watermarks can be set only once: a later call fails
+        /// with `GenericFailure` and the first settings stay in effect.
+        pub fn setBackpressure(self: *Self, config: ThreadSafeFunctionBackpressure) !void {
+            std.debug.assert(config.low_watermark < config.high_watermark);
+            if (self.backpressure_set.load(.acquire)) {
+                return NapiError.Error.fromReason("ThreadSafeFunction backpressure is already configured");
+            }
+            self.backpressure = config;
+            self.backpressure_set.store(true, .release);
+        }
+
+        /// Waits on the configured `std.Io` runtime until the function is not
+        /// backpressured. On an evented runtime the caller is suspended
+        /// instead of blocking its OS thread. Returns at once when no
+        /// watermarks are set.
+        pub fn reserve(self: *Self) !void {
+            const config = self.backpressureConfig() orelse return;
+            if (!self.backpressured.load(.acquire)) return;
+
+            try self.reserve_mutex.lock(config.io);
+            defer self.reserve_mutex.unlock(config.io);
+            while (self.backpressured.load(.acquire)) {
+                try self.reserve_cond.wait(config.io, &self.reserve_mutex);
+            }
+        }
+
+        /// Current counters, readable from any thread.
+        pub fn stats(self: *const Self) ThreadSafeFunctionStats {
+            return self.counters.snapshot();
         }
 
         pub fn acquire(self: *const Self) !void {
@@ -225,22 +437,22 @@ pub fn ThreadSafeFunction(comptime Args: type, comptime Return: type, comptime T
             }
         }
 
-        pub fn Ok(self: *const Self, args: Args, mode: ThreadSafeFunctionMode) !void {
+        pub fn Ok(self: *Self, args: Args, mode: ThreadSafeFunctionMode) !void {
             const args_data = self.allocator.create(Args) catch @panic("OOM");
             args_data.* = args;
 
             const data = self.allocator.create(CallData(Args)) catch @panic("OOM");
-            data.* = CallData(Args){ .args = args_data, .err = null };
+            data.* = CallData(Args){ .args = args_data, .err = null, .enqueued_at = 0 };
 
             try self.callThreadSafeFunction(data, mode);
         }
 
-        pub fn Err(self: *const Self, err: NapiError.Error, mode: ThreadSafeFunctionMode) !void {
+        pub fn Err(self: *Self, err: NapiError.Error, mode: ThreadSafeFunctionMode) !void {
             const actual_err = self.allocator.create(NapiError.Error) catch @panic("OOM");
             actual_err.* = err;
 
             const data = self.allocator.create(CallData(Args)) catch @panic("OOM");
-            data.* = CallData(Args){ .args = null, .err = actual_err };
+            data.* = CallData(Args){ .args = null, .err = actual_err, .enqueued_at = 0 };
 
             try self.callThreadSafeFunction(data, mode);
         }
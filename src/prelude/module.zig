@@ -8,6 +8,7 @@ const NapiError = @import("../napi/wrapper/error.zig");
 const Napi = @import("../napi/util/napi.zig").Napi;
 const Undefined = @import("../napi/value/undefined.zig").Undefined;
 const options = @import("../napi/options.zig");
+const async_runtime = @import("../napi/async.zig");
 
 pub fn NODE_API_MODULE_WITH_INIT(
     comptime name: []const u8,
@@ -62,6 +63,9 @@ pub fn NODE_API_MODULE_WITH_INIT(
                 };
             }
 
+            // After `init`, which may have replaced the pool settings.
+            defer async_runtime.warmStartThreadedRuntime(env);
+
             if (init) |init_fn| {
                 const result = init_fn(
                     Env.from_raw(env),
@@ -2,7 +2,7 @@ import { assert, assertEqual } from "./assert";
 import { runSuite } from "./native";
 
 runSuite("__ZIG_NAPI_ALLOCATOR_BUILTIN_RESULT__", (native) => {
-  assertEqual(native.allocator_kind(), "builtin-page", "builtin allocator kind");
+  assertEqual(native.allocator_kind(), "builtin-smp", "builtin allocator kind");
   assert(native.manual_allocation_roundtrip(64), "builtin allocator manual roundtrip");
 
   const copied = native.make_copied_buffer();
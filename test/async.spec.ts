@@ -1,4 +1,4 @@
-import { assertArrayEqual, assertEqual, assertRejects } from "./assert";
+import { assert, assertArrayEqual, assertEqual, assertRejects } from "./assert";
 
 type NativeAddon = ESObject;
 
@@ -69,6 +69,78 @@ export async function testAsync(native: NativeAddon) {
     "count_async_progress_thread current events",
   );
 
+  const concurrentEvents: Array<Array<number>> = [];
+  const concurrentResults = await Promise.all(
+    Array.from({ length: 64 }, (_, index) => {
+      const events: Array<number> = [];
+      concurrentEvents.push(events);
+      return native.count_async_progress_thread(index % 4, (event: ESObject) => events.push(event.current));
+    }),
+  );
+  concurrentResults.forEach((result: number, index: number) => {
+    assertEqual(result, index % 4, "concurrent thread task result");
+    assertArrayEqual(
+      concurrentEvents[index],
+      Array.from({ length: (index % 4) + 1 }, (_, current) => current),
+      "concurrent thread task events",
+    );
+  });
+
+  const latestEvents: Array<number> = [];
+  assertEqual(
+    await native.count_async_latest_thread(10000, (event: ESObject) => latestEvents.push(event.current)),
+    10000,
+    "count_async_latest_thread result",
+  );
+  assert(latestEvents.length > 0 && latestEvents.length <= 10001, "count_async_latest_thread event count");
+  assert(
+    latestEvents.every((current: number, index: number) => index === 0 || current > latestEvents[index - 1]),
+    "count_async_latest_thread events increase",
+  );
+  assertEqual(latestEvents[latestEvents.length - 1], 10000, "count_async_latest_thread last event");
+
+  const coalescedEvents: Array<number> = [];
+  let coalescedBatches = 0;
+  assertEqual(
+    await native.count_async_coalesced_thread(1000, (events: Array<ESObject>) => {
+      coalescedBatches += 1;
+      events.forEach((event: ESObject) => coalescedEvents.push(event.current));
+    }),
+    1000,
+    "count_async_coalesced_thread result",
+  );
+  assert(coalescedBatches > 0 && coalescedBatches <= coalescedEvents.length, "count_async_coalesced_thread batches");
+  assert(
+    coalescedEvents.every((current: number, index: number) => index === 0 || current > coalescedEvents[index - 1]),
+    "count_async_coalesced_thread events increase",
+  );
+  assertEqual(coalescedEvents[coalescedEvents.length - 1], 1000, "count_async_coalesced_thread last event");
+
+  // 10 Hz sampling; the task idles 300 ms after its burst, so the last value
+  // must come from the trailing wake-up rather than the completion flush.
+  const sampledEvents: Array<number> = [];
+  let sampledLastAt = 0;
+  const sampledStart = Date.now();
+  assertEqual(
+    await native.count_async_sampled_thread(100000, (event: ESObject) => {
+      sampledEvents.push(event.current);
+      if (event.current === 100000) sampledLastAt = Date.now();
+    }),
+    100000,
+    "count_async_sampled_thread result",
+  );
+  const sampledSettledAt = Date.now();
+  assert(
+    sampledEvents.length > 0 && sampledEvents.length <= Math.ceil((sampledSettledAt - sampledStart) / 100) + 2,
+    "count_async_sampled_thread event count",
+  );
+  assert(
+    sampledEvents.every((current: number, index: number) => index === 0 || current > sampledEvents[index - 1]),
+    "count_async_sampled_thread events increase",
+  );
+  assertEqual(sampledEvents[sampledEvents.length - 1], 100000, "count_async_sampled_thread last event");
+  assert(sampledSettledAt - sampledLastAt >= 100, "count_async_sampled_thread trailing delivery");
+
   const eventModeEvents: Array<ESObject> = [];
   assertEqual(
     await native.event_mode_progress_async(2, (event: ESObject) => eventModeEvents.push(event)),
@@ -86,4 +158,91 @@ export async function testAsync(native: NativeAddon) {
     "AbortError",
     "abortable_count_async pre-aborted",
   );
+
+  // Abort while the task runs: it stops at its next checkCancelled().
+  const runningSignal = abortSignal(false);
+  const running = native.wait_for_abort_async(5000, runningSignal);
+  runningSignal.aborted = true;
+  runningSignal.onabort.call(runningSignal);
+  await assertRejects(running, "AbortError", "wait_for_abort_async aborted while running");
+
+  const batchInputs = Array.from({ length: 1000 }, (_, index) => index);
+  const squares = await native.square_batch_async(batchInputs, abortSignal(false));
+  assertEqual(squares.length, batchInputs.length, "square_batch_async length");
+  assertArrayEqual(
+    Array.from(squares),
+    batchInputs.map((value) => value * value),
+    "square_batch_async results",
+  );
+  assertEqual((await native.square_batch_async([], abortSignal(false))).length, 0, "square_batch_async empty");
+  await assertRejects(
+    native.square_batch_async([2, 70000, 3], abortSignal(false)),
+    "Overflow",
+    "square_batch_async failure",
+  );
+  await assertRejects(
+    native.square_batch_async(batchInputs, abortSignal(true)),
+    "AbortError",
+    "square_batch_async pre-aborted",
+  );
+
+  const parallelValues = new Float64Array(100000).map((_, index) => index);
+  assertEqual(
+    await native.sum_float64_parallel_async(parallelValues, abortSignal(false)),
+    (parallelValues.length * (parallelValues.length - 1)) / 2,
+    "sum_float64_parallel_async result",
+  );
+  assertEqual(
+    await native.sum_float64_parallel_async(new Float64Array(0), abortSignal(false)),
+    0,
+    "sum_float64_parallel_async empty",
+  );
+  assertEqual(
+    await native.sum_float64_parallel_async(parallelValues.subarray(3, 10), abortSignal(false)),
+    42,
+    "sum_float64_parallel_async view",
+  );
+  await assertRejects(
+    native.sum_float64_parallel_async(parallelValues, abortSignal(true)),
+    "AbortError",
+    "sum_float64_parallel_async pre-aborted",
+  );
+
+  const doubled = new Float32Array(10000).map((_, index) => index);
+  await native.double_float32_parallel_async(doubled);
+  assertArrayEqual(
+    Array.from(doubled),
+    Array.from({ length: doubled.length }, (_, index) => index * 2),
+    "double_float32_parallel_async in place",
+  );
+
+  const indexed: Uint8Array = native.create_buffer();
+  await native.fill_buffer_index_parallel_async(indexed);
+  assertArrayEqual(
+    Array.from(indexed),
+    Array.from({ length: indexed.length }, (_, index) => index % 256),
+    "fill_buffer_index_parallel_async offsets",
+  );
+
+  const stream: ESObject = await native.count_stream_async(100);
+  assert(stream[Symbol.asyncIterator]() === stream, "count_stream_async is async iterable");
+  const streamed: Array<number> = [];
+  for (let step = await stream.next(); !step.done; step = await stream.next()) {
+    streamed.push(step.value.current);
+  }
+  assertArrayEqual(
+    streamed,
+    Array.from({ length: 100 }, (_, index) => index),
+    "count_stream_async events",
+  );
+  assertEqual((await stream.next()).done, true, "count_stream_async stays done");
+
+  const longStream: ESObject = await native.count_stream_async(1000000);
+  const partial: Array<number> = [];
+  while (partial.length < 3) {
+    partial.push((await longStream.next()).value.current);
+  }
+  assertEqual((await longStream.return()).done, true, "count_stream_async return");
+  assertEqual((await longStream.next()).done, true, "count_stream_async done after return");
+  assertArrayEqual(partial, [0, 1, 2], "count_stream_async early return");
 }
@@ -14,6 +14,16 @@ export function testBinary(native: NativeAddon) {
     "empty external buffer length",
   );
 
+  const borrowedBytes = new Uint8Array([1, 2, 3, 250]);
+  assertEqual(native.borrowed_bytes_sum(borrowedBytes), 256, "borrowed Uint8Array sum");
+  assertEqual(native.borrowed_bytes_sum(borrowedBytes.buffer), 256, "borrowed ArrayBuffer sum");
+  assertEqual(
+    native.borrowed_bytes_sum(borrowedBytes.subarray(1, 3)),
+    5,
+    "borrowed Uint8Array view sum",
+  );
+  assertEqual(native.borrowed_bytes_sum(native.create_empty_buffer_new()), 0, "borrowed empty sum");
+
   const arrayBufferValue = native.create_arraybuffer();
   assertEqual(native.get_arraybuffer(arrayBufferValue), 1024, "arraybuffer length");
   assertEqual(
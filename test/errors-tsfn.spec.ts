@@ -40,6 +40,91 @@ async function waitForThreadSafeFunction(native: NativeAddon) {
   });
 }
 
+async function waitForBatchedThreadSafeFunction(native: NativeAddon) {
+  const count = 1000;
+  await new Promise<void>((resolve, reject) => {
+    let received = 0;
+
+    try {
+      native.call_batched_thread_safe_function((batch: Float64Array) => {
+        try {
+          assert(batch instanceof Float64Array, "batched thread safe function packs numbers");
+          assert(batch.length > 0 && batch.length <= 64, "batched thread safe function batch size");
+          for (let i = 0; i < batch.length; i++) {
+            assertEqual(batch[i], received + i, "batched thread safe function order");
+          }
+          received += batch.length;
+          if (received === count) {
+            resolve();
+          }
+        } catch (callbackErr) {
+          reject(callbackErr);
+        }
+      }, count);
+    } catch (err) {
+      reject(err);
+    }
+  });
+}
+
+async function waitForDelayedBatchedThreadSafeFunction(native: NativeAddon) {
+  const started = Date.now();
+  const batch = await new Promise<Float64Array>((resolve, reject) => {
+    try {
+      native.call_delayed_batched_thread_safe_function((items: Float64Array) => resolve(items));
+    } catch (err) {
+      reject(err);
+    }
+  });
+  assertEqual(batch.length, 3, "batched thread safe function delivers items below the threshold");
+  assert(Date.now() - started < 500, "batched thread safe function honors max_delay_ns");
+}
+
+async function waitForObservedThreadSafeFunction(native: NativeAddon) {
+  const count = 200;
+  await new Promise<void>((resolve, reject) => {
+    let received = 0;
+
+    try {
+      native.call_observed_thread_safe_function((index: number, stats: ESObject) => {
+        try {
+          assertEqual(index, received, "observed thread safe function order");
+          assertEqual(stats.enqueued, index, "observed thread safe function enqueued");
+          assertEqual(stats.dropped, 0, "observed thread safe function dropped");
+          assert(stats.delivered <= stats.enqueued, "observed thread safe function delivered");
+          assert(stats.max_depth <= 16, "observed thread safe function high watermark");
+          received += 1;
+          if (received === count) {
+            resolve();
+          }
+        } catch (callbackErr) {
+          reject(callbackErr);
+        }
+      }, count);
+    } catch (err) {
+      reject(err);
+    }
+  });
+}
+
+function testThreadSafeFunctionReuse(native: NativeAddon) {
+  const listener = (_value: number) => {};
+  const other = (_value: number) => {};
+
+  // Each subscribe queues one call and reports the instance's queued count,
+  // so a shared instance keeps counting and a new one starts over.
+  const first = native.subscribe_thread_safe_function(listener);
+  const second = native.subscribe_thread_safe_function(listener);
+  const third = native.subscribe_thread_safe_function(other);
+  assertEqual(first, 1, "thread safe function queued count");
+  assertEqual(second, 2, "thread safe function reused for the same callback");
+  assertEqual(third, 1, "thread safe function created per callback");
+
+  native.unsubscribe_thread_safe_function(listener);
+  native.unsubscribe_thread_safe_function(listener);
+  native.unsubscribe_thread_safe_function(other);
+}
+
 export async function testErrorsAndThreadSafeFunction(native: NativeAddon) {
   assertThrows(() => native.throw_error(), "test", "throw_error repeat");
   assertThrows(() => native.throw_zig_error(), "ZigNativeFailure", "throw_zig_error");
@@ -50,4 +135,8 @@ export async function testErrorsAndThreadSafeFunction(native: NativeAddon) {
   assertThrows(() => native.result_after_try(false), "result type error", "result_after_try error");
   assertThrows(() => native.throw_zig_error_value(), "ZigValueFailure", "throw_zig_error_value");
   await waitForThreadSafeFunction(native);
+  testThreadSafeFunctionReuse(native);
+  await waitForBatchedThreadSafeFunction(native);
+  await waitForDelayedBatchedThreadSafeFunction(native);
+  await waitForObservedThreadSafeFunction(native);
 }
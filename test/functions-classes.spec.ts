@@ -27,6 +27,15 @@ export function testFunctionsAndClasses(native: NativeAddon) {
   assertEqual(initClassValue.name, "Init", "class init.name");
   assertEqual(initClassValue.age, 11, "class init.age");
 
+  // Spans several instance slabs; every instance must keep its own fields.
+  const pooledInstances = [];
+  for (let i = 0; i < 200; i += 1) {
+    pooledInstances.push(new native.TestWithInitClass(i, `Pooled${i}`));
+  }
+  assertEqual(pooledInstances[0].age, 0, "pooled class first.age");
+  assertEqual(pooledInstances[199].age, 199, "pooled class last.age");
+  assertEqual(pooledInstances[131].name, "Pooled131", "pooled class name");
+
   assertEqual(native.TestWithoutInitClass.hello, "Hello", "class without init static value");
 
   const factoryClassValue = native.TestFactoryClass.initWithFactory(13, "Factory");
@@ -38,6 +47,12 @@ export function testFunctionsAndClasses(native: NativeAddon) {
     "class factory format",
   );
 
+  const zigCreated = native.make_factory_instance(15, "Zig");
+  assertEqual(zigCreated instanceof native.TestFactoryClass, true, "class New instanceof");
+  assertEqual(zigCreated.name, "Zig", "class New.name");
+  assertEqual(zigCreated.age, 15, "class New.age");
+  assertEqual(zigCreated.format(), "TestFactory { name = Zig, age = 15 }", "class New format");
+
   const constructedFactory = new native.TestFactoryClass("Ctor", 14);
   assertEqual(constructedFactory.name, "Ctor", "class factory constructor.name");
   assertEqual(constructedFactory.age, 14, "class factory constructor.age");
@@ -46,4 +61,21 @@ export function testFunctionsAndClasses(native: NativeAddon) {
     "TestFactory { name = Ctor, age = 14 }",
     "class factory constructor format",
   );
+
+  const vec = new native.Vec3Class(1, 2, 3);
+  assertEqual(vec.x, 1, "shared class x");
+  assertEqual(vec.visible, true, "shared class bool field");
+  vec.x = 2;
+  assertEqual(vec.lengthSquared(), 17, "shared class sees JS writes");
+  vec.scale(2);
+  assertEqual(vec.y, 4, "shared class JS sees Zig writes");
+  vec.id = 65537;
+  assertEqual(vec.id, 1, "shared class u16 wraps like a DataView");
+  vec.visible = false;
+  assertEqual(vec.visible, false, "shared class bool write");
+  assertEqual(Object.getOwnPropertyNames(vec).length, 0, "shared class storage is not an own property");
+  assertEqual(Object.getOwnPropertySymbols(vec).length, 0, "shared class storage has no symbol key");
+  const other = new native.Vec3Class(5, 0, 0);
+  assertEqual(other.x, 5, "shared class instances have separate storage");
+  assertEqual(vec.x, 4, "shared class storage is per instance");
 }
@@ -7,6 +7,13 @@ export function testObjectsAndArrays(native: NativeAddon) {
   assertArrayEqual(native.get_arraylist([3, 2, 1]), [3, 2, 1], "arraylist roundtrip");
   assertEqual(native.raw_array_sum([1, 2, 3]), 6, "raw array sum");
   assertArrayEqual(native.raw_array_create(), [1, 4], "raw array create");
+
+  const largeArray: number[] = [];
+  for (let i = 0; i < 5000; i++) {
+    largeArray.push(i % 7);
+  }
+  assertArrayEqual(native.get_and_return_array(largeArray), largeArray, "large array roundtrip");
+  assertEqual(native.scoped_array_sum(largeArray), 14995, "scoped array sum");
   assertArrayEqual(
     native.get_named_array([7, true, "tuple"]),
     [7, true, "tuple"],
@@ -28,6 +35,34 @@ export function testObjectsAndArrays(native: NativeAddon) {
   );
   assertEqual(native.raw_object_create("answer", 42).answer, 42, "raw object create");
 
+  // ArkVM builds cache comptime property keys per env: the first call
+  // creates them, the later ones reuse them. Key order in the input differs
+  // per round, so a key bound to the wrong field would change the sum.
+  for (let round = 0; round < 3; round++) {
+    const wide: ESObject = {};
+    for (let i = 0; i < 16; i++) {
+      const field = round % 2 === 0 ? i : 15 - i;
+      wide[`f${field}`] = field + round;
+    }
+    assertEqual(native.wide_object_weighted_sum(wide), 1240 + 120 * round, `wide object read round ${round}`);
+
+    const made = native.wide_object_make(round);
+    assertArrayEqual(
+      Object.keys(made),
+      Array.from({ length: 16 }, (_, i) => `f${i}`),
+      `wide object write keys round ${round}`,
+    );
+    assertArrayEqual(
+      Object.keys(made).map((key: string) => made[key]),
+      Array.from({ length: 16 }, (_, i) => i + round),
+      `wide object write values round ${round}`,
+    );
+
+    const swapped = native.named_object_swap({ left: round, right: -round - 1 });
+    assertEqual(swapped.left, -round - 1, `named object swap left round ${round}`);
+    assertEqual(swapped.right, round, `named object swap right round ${round}`);
+  }
+
   const optionalDefaults = native.get_object_optional({ name: "Defaulted" });
   assertEqual(optionalDefaults.name, "Defaulted", "object optional.name");
   assertEqual(optionalDefaults.age, 18, "object optional default age");
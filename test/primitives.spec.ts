@@ -12,6 +12,26 @@ export function testPrimitives(native: NativeAddon) {
   assertEqual(native.hello(""), "Hello, !", "hello empty");
   assertEqual(native.raw_string_len("ArkTS"), 5, "raw_string_len");
   assertEqual(native.copied_string_len("ArkTS"), 5, "copied_string_len");
+  assertEqual(native.small_string_len("ArkTS"), 5, "small_string_len inline");
+  assertEqual(native.small_string_len("ArkTS runtime"), 13, "small_string_len heap");
+  assertEqual(native.small_string_len("\u00e9t\u00e9"), 5, "small_string_len utf8");
+  assertEqual(native.small_string_is_inline("ArkTS"), true, "small_string inline");
+  assertEqual(native.small_string_is_inline("ArkTS-VM"), true, "small_string inline at capacity");
+  assertEqual(native.small_string_is_inline("ArkTS runtime"), false, "small_string heap");
+  assertEqual(native.small_string_echo("id-42"), "id-42", "small_string_echo inline");
+  assertEqual(
+    native.small_string_echo("OpenHarmony ArkVM"),
+    "OpenHarmony ArkVM",
+    "small_string_echo heap",
+  );
+  assertEqual(
+    native.external_static_string(),
+    "zig-napi external string",
+    "external static string",
+  );
+  assertEqual(native.external_owned_string(40), "z".repeat(40), "external owned string");
+  assertEqual(native.external_owned_string(0), "", "external owned empty string");
+  assertEqual(native.external_utf8_string(), "caf\u00e9", "external utf8 fallback string");
   assertEqual(native.text, "Hello World", "const text");
 
   assertThrows(() => native.throw_error(), "test", "throw_error");